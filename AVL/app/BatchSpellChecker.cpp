@@ -0,0 +1,267 @@
+// BatchSpellChecker.cpp
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "BatchSpellChecker.hpp"
+#include "MappedFile.hpp"
+
+
+namespace
+{
+    // The number of chunks per thread that can be finished but not yet
+    // written out before the threads wait for the writing to catch up.
+    constexpr std::size_t CHUNKS_AHEAD_PER_THREAD = 4;
+
+
+    bool isLetter(char c) noexcept
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+    }
+
+
+    char toUpper(char c) noexcept
+    {
+        return c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c;
+    }
+
+
+    // Splits the text into chunks of about the given size, moving the end
+    // of each one forward past the rest of any word it would cut in two.
+    std::vector<std::string_view> splitIntoChunks(std::string_view text, std::size_t chunkSize)
+    {
+        std::vector<std::string_view> chunks;
+        std::size_t start = 0;
+
+        while (start < text.size())
+        {
+            std::size_t end = std::min(start + chunkSize, text.size());
+
+            while (end < text.size() && isLetter(text[end]))
+            {
+                ++end;
+            }
+
+            chunks.push_back(text.substr(start, end - start));
+            start = end;
+        }
+
+        return chunks;
+    }
+}
+
+
+
+double BatchSpellCheckReport::megabytesPerSecond() const noexcept
+{
+    return seconds > 0.0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0;
+}
+
+
+
+struct BatchSpellChecker::ChunkResult
+{
+    // The lines to write out for the chunk.
+    std::string output;
+
+    std::size_t words = 0;
+    std::size_t distinctWords = 0;
+    std::size_t misspelledWords = 0;
+
+    bool finished = false;
+    std::exception_ptr error;
+};
+
+
+BatchSpellChecker::BatchSpellChecker(
+    const WordChecker& checker, unsigned int threadCount, std::size_t chunkSize)
+    : checker{checker},
+      threadCount{threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())},
+      chunkSize{std::max<std::size_t>(chunkSize, 1)}
+{
+}
+
+
+BatchSpellCheckReport BatchSpellChecker::check(std::string_view text, std::ostream& out) const
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::string_view> chunks = splitIntoChunks(text, chunkSize);
+    std::vector<ChunkResult> results(chunks.size());
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::size_t written = 0;
+    bool stopping = false;
+
+    std::atomic<std::size_t> nextChunk{0};
+    std::size_t chunksAhead = CHUNKS_AHEAD_PER_THREAD * threadCount;
+
+    // Each thread takes the next chunk not yet taken, so chunks are taken
+    // in order, and the earliest unwritten chunk is always being worked
+    // on; that's why waiting for the writing to catch up can't deadlock.
+    auto work =
+        [&]
+        {
+            for (std::size_t i = nextChunk++; i < chunks.size(); i = nextChunk++)
+            {
+                {
+                    std::unique_lock<std::mutex> lock{mutex};
+                    changed.wait(lock, [&] { return stopping || i < written + chunksAhead; });
+
+                    if (stopping)
+                    {
+                        return;
+                    }
+                }
+
+                ChunkResult result;
+
+                try
+                {
+                    checkChunk(chunks[i], result);
+                }
+                catch (...)
+                {
+                    result.error = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock{mutex};
+                results[i] = std::move(result);
+                results[i].finished = true;
+                changed.notify_all();
+            }
+        };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+
+    for (unsigned int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back(work);
+    }
+
+    BatchSpellCheckReport report;
+    report.bytes = text.size();
+
+    std::exception_ptr error;
+
+    for (std::size_t i = 0; i < chunks.size() && !error; ++i)
+    {
+        ChunkResult result;
+
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            changed.wait(lock, [&] { return results[i].finished; });
+            result = std::move(results[i]);
+        }
+
+        if (result.error)
+        {
+            error = result.error;
+        }
+        else
+        {
+            out << result.output;
+
+            report.words += result.words;
+            report.distinctWords += result.distinctWords;
+            report.misspelledWords += result.misspelledWords;
+        }
+
+        std::lock_guard<std::mutex> lock{mutex};
+        written = i + 1;
+        stopping = error != nullptr;
+        changed.notify_all();
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+
+    out.flush();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    report.seconds = elapsed.count();
+
+    return report;
+}
+
+
+BatchSpellCheckReport BatchSpellChecker::checkFile(const std::string& path, std::ostream& out) const
+{
+    MappedFile file{path};
+    file.adviseSequential();
+
+    return check(file.contents(), out);
+}
+
+
+void BatchSpellChecker::checkChunk(std::string_view chunk, ChunkResult& result) const
+{
+    std::unordered_set<std::string> seen;
+    std::string word;
+
+    std::size_t i = 0;
+
+    while (i < chunk.size())
+    {
+        if (!isLetter(chunk[i]))
+        {
+            ++i;
+            continue;
+        }
+
+        word.clear();
+
+        for (; i < chunk.size() && isLetter(chunk[i]); ++i)
+        {
+            word += toUpper(chunk[i]);
+        }
+
+        ++result.words;
+
+        if (!seen.insert(word).second)
+        {
+            continue;
+        }
+
+        ++result.distinctWords;
+
+        if (checker.wordExists(word))
+        {
+            continue;
+        }
+
+        ++result.misspelledWords;
+
+        result.output += word;
+        result.output += ':';
+
+        for (const std::string& suggestion : checker.findSuggestions(word))
+        {
+            result.output += ' ';
+            result.output += suggestion;
+            result.output += ',';
+        }
+
+        if (result.output.back() == ',')
+        {
+            result.output.pop_back();
+        }
+
+        result.output += '\n';
+    }
+}
@@ -0,0 +1,82 @@
+// BatchSpellChecker.hpp
+//
+// A BatchSpellChecker spell-checks a whole document (which can be many
+// gigabytes long) at once, rather than one word at a time.
+//
+// The document is mapped into memory and split into chunks, each ending
+// at a word boundary, which a pool of threads checks in parallel against
+// the same (read-only) dictionary.  Each chunk is tokenized into words
+// (runs of letters, converted to uppercase), and each distinct word in
+// the chunk is looked up only once, no matter how often it appears.  The
+// misspelled words are written out chunk by chunk, in the order they
+// first appear in the document, along with their suggestions; a chunk is
+// written as soon as it and every chunk before it are finished, and only
+// a limited number of chunks are allowed to be finished but unwritten at
+// once, so memory use doesn't grow with the size of the document.
+
+#ifndef BATCHSPELLCHECKER_HPP
+#define BATCHSPELLCHECKER_HPP
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "WordChecker.hpp"
+
+
+
+struct BatchSpellCheckReport
+{
+    std::size_t bytes = 0;
+    std::size_t words = 0;
+
+    // Distinct words are counted once per chunk they appear in.
+    std::size_t distinctWords = 0;
+    std::size_t misspelledWords = 0;
+
+    double seconds = 0.0;
+
+    double megabytesPerSecond() const noexcept;
+};
+
+
+
+class BatchSpellChecker
+{
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 4 * 1024 * 1024;
+
+    // Builds a BatchSpellChecker that checks words with the given
+    // WordChecker, using the given number of threads (or one per core, if
+    // it's zero) and chunks of about the given size.  The WordChecker, and
+    // the Set it checks against, must not change while a check is running.
+    explicit BatchSpellChecker(
+        const WordChecker& checker, unsigned int threadCount = 0,
+        std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+
+    // check() spell-checks the given text, writing a line to the given
+    // stream for each misspelled word (as described above) and returning
+    // a summary of what was done.
+    BatchSpellCheckReport check(std::string_view text, std::ostream& out) const;
+
+
+    // checkFile() spell-checks the contents of the file with the given
+    // path, which is mapped into memory rather than read, throwing a
+    // MappedFileException if that fails.
+    BatchSpellCheckReport checkFile(const std::string& path, std::ostream& out) const;
+
+
+private:
+    struct ChunkResult;
+
+    void checkChunk(std::string_view chunk, ChunkResult& result) const;
+
+private:
+    const WordChecker& checker;
+    unsigned int threadCount;
+    std::size_t chunkSize;
+};
+
+
+
+#endif
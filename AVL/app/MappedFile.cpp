@@ -0,0 +1,74 @@
+// MappedFile.cpp
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedFile.hpp"
+
+
+MappedFile::MappedFile(const std::string& path)
+    : data{nullptr}, length{0}
+{
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        throw MappedFileException{"Cannot open " + path + ": " + std::strerror(errno)};
+    }
+
+    struct stat status;
+
+    if (fstat(fd, &status) < 0)
+    {
+        int error = errno;
+        close(fd);
+        throw MappedFileException{"Cannot read the size of " + path + ": " + std::strerror(error)};
+    }
+
+    length = status.st_size;
+
+    // An empty file can't be mapped, but it doesn't need to be.
+    if (length > 0)
+    {
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (mapped == MAP_FAILED)
+        {
+            int error = errno;
+            close(fd);
+            throw MappedFileException{"Cannot map " + path + ": " + std::strerror(error)};
+        }
+
+        data = static_cast<const char*>(mapped);
+    }
+
+    // The mapping stays valid after the file is closed.
+    close(fd);
+}
+
+
+MappedFile::~MappedFile() noexcept
+{
+    if (data != nullptr)
+    {
+        munmap(const_cast<char*>(data), length);
+    }
+}
+
+
+std::string_view MappedFile::contents() const noexcept
+{
+    return std::string_view{data, length};
+}
+
+
+void MappedFile::adviseSequential() const noexcept
+{
+    if (data != nullptr)
+    {
+        madvise(const_cast<char*>(data), length, MADV_SEQUENTIAL);
+    }
+}
@@ -0,0 +1,58 @@
+// MappedFile.hpp
+//
+// A MappedFile maps the whole of a file into memory, read-only, for as
+// long as it exists, so that the file's contents can be read as one big
+// string_view without copying them.  The operating system pages the
+// contents in as they're read and can drop them again under memory
+// pressure, so even files much larger than memory can be mapped.
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+
+
+class MappedFileException : public std::runtime_error
+{
+public:
+    explicit MappedFileException(const std::string& reason)
+        : std::runtime_error{reason}
+    {
+    }
+};
+
+
+
+class MappedFile
+{
+public:
+    // Maps the file with the given path into memory, throwing a
+    // MappedFileException if it can't be opened or mapped.
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile() noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+
+    // contents() returns the contents of the file.
+    std::string_view contents() const noexcept;
+
+
+    // adviseSequential() tells the operating system that the file will be
+    // read from start to finish, so it can read ahead more aggressively.
+    void adviseSequential() const noexcept;
+
+
+private:
+    const char* data;
+    std::size_t length;
+};
+
+
+
+#endif
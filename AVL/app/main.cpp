@@ -1,12 +1,153 @@
 // main.cpp
+//
+// With no arguments, runs the interactive spell-checking shell.  Given
+//
+//     --batch WORDLIST DOCUMENT [THREADS]
+//
+// it instead spell-checks the whole document against the words in the
+// word list (one per line), writing each misspelled word and its
+// suggestions to the standard output and a summary, including the
+// throughput, to the standard error.
 
 
+#include <fstream>
 #include <iostream>
+#include <string>
+#include "BatchSpellChecker.hpp"
+#include "HashSet.hpp"
+#include "MappedFile.hpp"
 #include "SpellCheckShell.hpp"
+#include "SuggestionCache.hpp"
+#include "WordChecker.hpp"
 
 
-int main()
+namespace
 {
+    // The number of misspelled words whose suggestions are cached in
+    // batch mode, since the same misspellings turn up again and again.
+    constexpr std::size_t SUGGESTION_CACHE_CAPACITY = 65536;
+
+    // The most threads that batch mode can be asked to use.
+    constexpr unsigned int MAX_THREADS = 4096;
+
+
+    unsigned int hashWord(const std::string& word)
+    {
+        unsigned int hash = 2166136261u;
+
+        for (char c : word)
+        {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+        }
+
+        return hash;
+    }
+
+
+    // parseThreadCount() stores the number of threads given on the
+    // command line in threadCount, returning false instead if the text
+    // isn't a whole number from 0 to MAX_THREADS.
+    bool parseThreadCount(const std::string& text, unsigned int& threadCount)
+    {
+        // Nine digits or fewer always fit in an unsigned int, so std::stoul()
+        // can't fail or overflow below.
+        if (text.empty() || text.size() > 9
+            || text.find_first_not_of("0123456789") != std::string::npos)
+        {
+            return false;
+        }
+
+        unsigned int count = std::stoul(text);
+
+        if (count > MAX_THREADS)
+        {
+            return false;
+        }
+
+        threadCount = count;
+        return true;
+    }
+
+
+    int runBatch(int argc, char** argv)
+    {
+        if (argc < 4 || argc > 5)
+        {
+            std::cerr << "usage: " << argv[0] << " --batch WORDLIST DOCUMENT [THREADS]" << std::endl;
+            return 1;
+        }
+
+        unsigned int threadCount = 0;
+
+        if (argc == 5 && !parseThreadCount(argv[4], threadCount))
+        {
+            std::cerr << "ERROR: THREADS must be a whole number from 0 to " << MAX_THREADS
+                      << ", not " << argv[4] << std::endl;
+            std::cerr << "usage: " << argv[0] << " --batch WORDLIST DOCUMENT [THREADS]" << std::endl;
+            return 1;
+        }
+
+        std::ifstream wordList{argv[2]};
+
+        if (!wordList)
+        {
+            std::cerr << "ERROR: cannot open " << argv[2] << std::endl;
+            return 1;
+        }
+
+        HashSet<std::string> words{hashWord};
+        std::string word;
+
+        while (std::getline(wordList, word))
+        {
+            if (!word.empty())
+            {
+                words.add(word);
+            }
+        }
+
+        WordChecker generator{words};
+        SuggestionCache cache{generator, SUGGESTION_CACHE_CAPACITY};
+
+        WordChecker checker{words};
+        checker.setSuggestionEngine(&cache);
+
+        BatchSpellChecker batch{checker, threadCount};
+
+        try
+        {
+            BatchSpellCheckReport report = batch.checkFile(argv[3], std::cout);
+
+            std::cerr << report.bytes << " bytes, "
+                      << report.words << " words, "
+                      << report.misspelledWords << " misspelled, in "
+                      << report.seconds << " s ("
+                      << report.megabytesPerSecond() << " MB/s)" << std::endl;
+
+            SuggestionCacheStats stats = cache.stats();
+
+            std::cerr << "suggestion cache: " << stats.entries << " entries, "
+                      << stats.bytes / 1024 << " KB, "
+                      << stats.hitRate() * 100.0 << "% hits" << std::endl;
+        }
+        catch (MappedFileException& e)
+        {
+            std::cerr << "ERROR: " << e.what() << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::string{argv[1]} == "--batch")
+    {
+        return runBatch(argc, argv);
+    }
+
     try
     {
         SpellCheckShell shell;
@@ -19,4 +160,3 @@ int main()
 
     return 0;
 }
-
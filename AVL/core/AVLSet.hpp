@@ -4,7 +4,9 @@
 #ifndef AVLSET_HPP
 #define AVLSET_HPP
 
+#include <exception>
 #include <functional>
+#include <thread>
 #include "Set.hpp"
 
 
@@ -55,6 +57,18 @@ public:
     bool contains(const ElementType& element) const override;
 
 
+    // assignSorted() replaces the contents of the set with the elements in
+    // the range [first, last), which must be distinct and in ascending
+    // order (and can be anything an ElementType can be constructed from).
+    // The tree is built perfectly balanced, each node's subtrees from the
+    // elements to either side of its own, in O(n) time; the top few
+    // levels' subtrees are built by separate threads, up to the given
+    // number of them.  If constructing an element throws, the exception is
+    // rethrown here, and the set is left empty.
+    template <typename RandomAccessIterator>
+    void assignSorted(RandomAccessIterator first, RandomAccessIterator last, unsigned int threadCount = 1);
+
+
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
@@ -94,12 +108,15 @@ private:
         Node* right;
 
     };
-    void deleteElements(Node* n);
+    static void deleteElements(Node* n);
     void copyElements(Node*& copyOne, Node* copyTwo);
     void preorderTraversal(Node* node, VisitFunction visited) const;
     void postorderTraversal(Node* node, VisitFunction visited) const;
     void inorderTraversal(Node* node, VisitFunction visited) const;
 
+    template <typename RandomAccessIterator>
+    static Node* buildBalanced(RandomAccessIterator first, RandomAccessIterator last, unsigned int threadCount);
+
 
     Node* root;
     int treeHeight;
@@ -298,6 +315,97 @@ bool AVLSet<ElementType>::contains(const ElementType& element) const
 }
 
 
+template <typename ElementType>
+template <typename RandomAccessIterator>
+void AVLSet<ElementType>::assignSorted(
+    RandomAccessIterator first, RandomAccessIterator last, unsigned int threadCount)
+{
+    deleteElements(root);
+    root = nullptr;
+    sz = 0;
+    treeHeight = -1;
+
+    root = buildBalanced(first, last, threadCount);
+    sz = last - first;
+
+    // A perfectly balanced tree of n nodes has height floor(log2(n)).
+    for (unsigned int n = sz; n > 0; n /= 2)
+    {
+        treeHeight++;
+    }
+}
+
+
+template <typename ElementType>
+template <typename RandomAccessIterator>
+typename AVLSet<ElementType>::Node* AVLSet<ElementType>::buildBalanced(
+    RandomAccessIterator first, RandomAccessIterator last, unsigned int threadCount)
+{
+    if (first == last)
+    {
+        return nullptr;
+    }
+
+    RandomAccessIterator middle = first + (last - first) / 2;
+    Node* node = new Node{ElementType(*middle), nullptr, nullptr};
+
+    // A subtree that fails to build has already freed its own nodes, so
+    // only this node and the subtree that was built are left to free.
+    try
+    {
+        // Threads are only worth starting for subtrees big enough to keep
+        // them busy for a while.  An exception on the other thread is
+        // caught there and rethrown on this one once it's joined.
+        if (threadCount > 1 && last - first > 4096)
+        {
+            std::exception_ptr leftFailure;
+
+            std::thread left{
+                [&]
+                {
+                    try
+                    {
+                        node->left = buildBalanced(first, middle, threadCount / 2);
+                    }
+                    catch (...)
+                    {
+                        leftFailure = std::current_exception();
+                    }
+                }};
+
+            try
+            {
+                node->right = buildBalanced(middle + 1, last, threadCount - threadCount / 2);
+            }
+            catch (...)
+            {
+                left.join();
+                throw;
+            }
+
+            left.join();
+
+            if (leftFailure)
+            {
+                std::rethrow_exception(leftFailure);
+            }
+        }
+        else
+        {
+            node->left = buildBalanced(first, middle, 1);
+            node->right = buildBalanced(middle + 1, last, 1);
+        }
+    }
+    catch (...)
+    {
+        deleteElements(node);
+        throw;
+    }
+
+    return node;
+}
+
+
 template <typename ElementType>
 unsigned int AVLSet<ElementType>::size() const noexcept
 {
@@ -0,0 +1,200 @@
+// BKTree.cpp
+
+#include <algorithm>
+#include <random>
+#include "BKTree.hpp"
+#include "Levenshtein.hpp"
+
+
+BKTree::BKTree(std::vector<std::string> words, unsigned int maxDistance)
+    : maxDist{maxDistance}, words{std::move(words)}
+{
+    std::sort(this->words.begin(), this->words.end());
+    this->words.erase(std::unique(this->words.begin(), this->words.end()), this->words.end());
+
+    if (this->words.empty())
+    {
+        return;
+    }
+
+    // Adding words in sorted order would make neighboring words (which
+    // share long prefixes, so are close together) pile up along the same
+    // paths, so they're added in a fixed shuffled order instead.
+    std::vector<unsigned int> order(this->words.size());
+
+    for (unsigned int i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+
+    std::shuffle(order.begin(), order.end(), std::mt19937{order.size()});
+
+    // While building, each node's children are kept in their own vector.
+    std::vector<unsigned int> treeWords{order[0]};
+    std::vector<std::vector<Edge>> children(1);
+
+    for (std::size_t i = 1; i < order.size(); ++i)
+    {
+        LevenshteinMatcher matcher{this->words[order[i]]};
+        unsigned int node = 0;
+
+        while (true)
+        {
+            unsigned int d = matcher.distance(this->words[treeWords[node]]);
+
+            auto child = std::find_if(
+                children[node].begin(), children[node].end(),
+                [d](const Edge& edge)
+                {
+                    return edge.distance == d;
+                });
+
+            if (child == children[node].end())
+            {
+                children[node].push_back(Edge{d, static_cast<unsigned int>(treeWords.size())});
+                treeWords.push_back(order[i]);
+                children.emplace_back();
+                break;
+            }
+
+            node = child->child;
+        }
+    }
+
+    nodes.reserve(treeWords.size());
+    edges.reserve(treeWords.size() - 1);
+
+    for (unsigned int node = 0; node < treeWords.size(); ++node)
+    {
+        std::sort(
+            children[node].begin(), children[node].end(),
+            [](const Edge& a, const Edge& b)
+            {
+                return a.distance < b.distance;
+            });
+
+        unsigned int first = edges.size();
+        edges.insert(edges.end(), children[node].begin(), children[node].end());
+        nodes.push_back(Node{treeWords[node], first, static_cast<unsigned int>(edges.size())});
+    }
+}
+
+
+std::vector<std::pair<std::string, unsigned int>> BKTree::findWithin(
+    std::string_view word, unsigned int distance) const
+{
+    std::vector<std::pair<unsigned int, unsigned int>> found;
+
+    if (nodes.empty())
+    {
+        return {};
+    }
+
+    LevenshteinMatcher matcher{word};
+    std::vector<unsigned int> pending{0};
+
+    while (!pending.empty())
+    {
+        const Node& node = nodes[pending.back()];
+        pending.pop_back();
+
+        unsigned int d = matcher.distance(words[node.word]);
+
+        if (d <= distance)
+        {
+            found.emplace_back(d, node.word);
+        }
+
+        unsigned int low = d > distance ? d - distance : 0;
+        unsigned int high = d + distance;
+
+        auto first = edges.begin() + node.firstEdge;
+        auto last = edges.begin() + node.lastEdge;
+
+        first = std::lower_bound(
+            first, last, low,
+            [](const Edge& edge, unsigned int value)
+            {
+                return edge.distance < value;
+            });
+
+        for (; first != last && first->distance <= high; ++first)
+        {
+            pending.push_back(first->child);
+        }
+    }
+
+    // Sorting by position in words, within each distance, sorts the words
+    // alphabetically.
+    std::sort(found.begin(), found.end());
+
+    std::vector<std::pair<std::string, unsigned int>> result;
+    result.reserve(found.size());
+
+    for (const auto& [d, w] : found)
+    {
+        result.emplace_back(words[w], d);
+    }
+
+    return result;
+}
+
+
+std::vector<std::string> BKTree::findSuggestions(const std::string& word) const
+{
+    std::vector<std::string> suggestions;
+
+    for (auto& [suggestion, distance] : findWithin(word, maxDist))
+    {
+        suggestions.push_back(std::move(suggestion));
+    }
+
+    impl_::addSplits(word, [this](std::string_view s) { return contains(s); }, suggestions);
+
+    return suggestions;
+}
+
+
+bool BKTree::contains(std::string_view word) const
+{
+    return std::binary_search(words.begin(), words.end(), word);
+}
+
+
+unsigned int BKTree::size() const noexcept
+{
+    return words.size();
+}
+
+
+unsigned int BKTree::maxDistance() const noexcept
+{
+    return maxDist;
+}
+
+
+void BKTree::setMaxDistance(unsigned int maxDistance) noexcept
+{
+    maxDist = maxDistance;
+}
+
+
+unsigned int BKTree::depth() const
+{
+    // Every child comes after its parent in nodes, so each node's depth
+    // is known before its children's are needed.
+    std::vector<unsigned int> depths(nodes.size(), 1);
+    unsigned int deepest = 0;
+
+    for (unsigned int i = 0; i < nodes.size(); ++i)
+    {
+        deepest = std::max(deepest, depths[i]);
+
+        for (unsigned int e = nodes[i].firstEdge; e < nodes[i].lastEdge; ++e)
+        {
+            depths[edges[e].child] = depths[i] + 1;
+        }
+    }
+
+    return deepest;
+}
@@ -0,0 +1,103 @@
+// BKTree.hpp
+//
+// A BKTree (Burkhard-Keller tree) is a SuggestionEngine that finds the
+// words in a dictionary within any edit distance of a misspelled one,
+// nearest first, without comparing it to every word.
+//
+// Each node holds one word, and its children are labeled by their edit
+// distance from it: every word in the subtree labeled d is exactly d
+// edits away from the node's word.  Edit distance obeys the triangle
+// inequality, so if the misspelled word is at distance d from a node's
+// word, only words in the subtrees labeled d - k through d + k can be
+// within distance k of it, and all the others are skipped without being
+// looked at.  Distances are measured with a LevenshteinMatcher.
+//
+// The tree is built one word at a time and then flattened, so that each
+// node's children are stored contiguously, in order of their labels.
+
+#ifndef BKTREE_HPP
+#define BKTREE_HPP
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "SuggestionEngine.hpp"
+
+
+
+class BKTree : public SuggestionEngine
+{
+public:
+    // Builds a BKTree containing the given words, which can be in any
+    // order and can contain duplicates.  findSuggestions() returns the
+    // words within the given edit distance; findWithin() can use any.
+    explicit BKTree(std::vector<std::string> words, unsigned int maxDistance = 2);
+
+
+    // findWithin() returns the words within the given edit distance of
+    // the given word, along with their distances, nearest first and
+    // alphabetically among words at the same distance.
+    std::vector<std::pair<std::string, unsigned int>> findWithin(
+        std::string_view word, unsigned int distance) const;
+
+
+    // findSuggestions() returns the words within the tree's maximum edit
+    // distance of the given word, nearest first, followed by the word's
+    // splits into two words (see addSplits() in SuggestionEngine.hpp).
+    std::vector<std::string> findSuggestions(const std::string& word) const override;
+
+
+    // contains() returns true if the given word is in the dictionary.
+    bool contains(std::string_view word) const;
+
+
+    // size() returns the number of distinct words in the dictionary.
+    unsigned int size() const noexcept;
+
+
+    // maxDistance() returns the edit distance that findSuggestions() uses.
+    unsigned int maxDistance() const noexcept;
+
+
+    // setMaxDistance() changes the edit distance that findSuggestions()
+    // uses; the tree doesn't need to be rebuilt.
+    void setMaxDistance(unsigned int maxDistance) noexcept;
+
+
+    // depth() returns the number of nodes on the longest path from the
+    // root to a leaf.
+    unsigned int depth() const;
+
+
+private:
+    struct Node
+    {
+        // Position of the node's word in words.
+        unsigned int word;
+
+        // The node's children are edges[firstEdge] up to edges[lastEdge].
+        unsigned int firstEdge;
+        unsigned int lastEdge;
+    };
+
+    struct Edge
+    {
+        unsigned int distance;
+        unsigned int child;
+    };
+
+private:
+    unsigned int maxDist;
+
+    // The dictionary, sorted.
+    std::vector<std::string> words;
+
+    // The root is nodes[0], if there are any.
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+};
+
+
+
+#endif
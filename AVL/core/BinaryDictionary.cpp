@@ -0,0 +1,275 @@
+// BinaryDictionary.cpp
+
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+#include "BinaryDictionary.hpp"
+
+
+namespace
+{
+    constexpr char MAGIC[8] = {'W', 'O', 'R', 'D', 'D', 'I', 'C', 'T'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr std::uint32_t SORTED = 1;
+
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t flags;
+        std::uint32_t count;
+        std::uint32_t reserved;
+        std::uint64_t textSize;
+    };
+
+
+    template <typename T>
+    void writeArray(std::ofstream& out, const T* data, std::size_t count)
+    {
+        out.write(reinterpret_cast<const char*>(data), count * sizeof(T));
+    }
+}
+
+
+
+void BinaryDictionary::write(const std::string& path, std::vector<std::string> words, bool sort)
+{
+    if (sort)
+    {
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+    }
+    else
+    {
+        // Only the first copy of each word is kept, where it appears.
+        std::unordered_set<std::string_view> seen;
+        std::vector<std::string> distinct;
+
+        for (std::string& word : words)
+        {
+            if (seen.insert(word).second)
+            {
+                distinct.push_back(word);
+            }
+        }
+
+        words = std::move(distinct);
+    }
+
+    std::vector<std::uint32_t> offsets{0};
+    std::vector<std::uint32_t> hashes;
+    std::uint64_t textSize = 0;
+
+    for (const std::string& word : words)
+    {
+        textSize += word.size();
+
+        if (textSize > UINT32_MAX)
+        {
+            throw BinaryDictionaryException{"Too much text for a binary dictionary"};
+        }
+
+        offsets.push_back(textSize);
+        hashes.push_back(hash(word));
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.flags = sort ? SORTED : 0;
+    header.count = words.size();
+    header.textSize = textSize;
+
+    std::ofstream out{path, std::ios::binary};
+
+    if (!out)
+    {
+        throw BinaryDictionaryException{"Cannot create " + path};
+    }
+
+    writeArray(out, &header, 1);
+    writeArray(out, offsets.data(), offsets.size());
+    writeArray(out, hashes.data(), hashes.size());
+
+    for (const std::string& word : words)
+    {
+        out.write(word.data(), word.size());
+    }
+
+    if (!out.flush())
+    {
+        throw BinaryDictionaryException{"Cannot write " + path};
+    }
+}
+
+
+unsigned int BinaryDictionary::hash(const std::string& word) noexcept
+{
+    return hash(std::string_view{word});
+}
+
+
+unsigned int BinaryDictionary::hash(std::string_view word) noexcept
+{
+    // 32-bit FNV-1a.
+    std::uint32_t h = 2166136261u;
+
+    for (char c : word)
+    {
+        h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+
+    return h;
+}
+
+
+BinaryDictionary::BinaryDictionary(const std::string& path)
+    : count{0}, flags{0}, offsets{nullptr}, hashes{nullptr}, text{nullptr}
+{
+    std::ifstream in{path, std::ios::binary | std::ios::ate};
+
+    if (!in)
+    {
+        throw BinaryDictionaryException{"Cannot open " + path};
+    }
+
+    std::size_t fileSize = in.tellg();
+    in.seekg(0);
+
+    if (fileSize < sizeof(Header))
+    {
+        throw BinaryDictionaryException{path + " is not a binary dictionary"};
+    }
+
+    // The contents are read into memory that isn't initialized first,
+    // which for a large file is a noticeable part of the time.
+    contents.reset(new char[fileSize]);
+
+    if (!in.read(contents.get(), fileSize))
+    {
+        throw BinaryDictionaryException{"Cannot read " + path};
+    }
+
+    Header header;
+    std::memcpy(&header, contents.get(), sizeof(Header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION)
+    {
+        throw BinaryDictionaryException{path + " is not a binary dictionary"};
+    }
+
+    std::uint64_t expectedSize =
+        sizeof(Header) + 4 * (std::uint64_t{header.count} * 2 + 1) + header.textSize;
+
+    if (fileSize != expectedSize)
+    {
+        throw BinaryDictionaryException{path + " is truncated or corrupt"};
+    }
+
+    count = header.count;
+    flags = header.flags;
+    offsets = reinterpret_cast<const std::uint32_t*>(contents.get() + sizeof(Header));
+    hashes = offsets + count + 1;
+    text = reinterpret_cast<const char*>(hashes + count);
+
+    // Loading a sorted dictionary trusts its order (and so that its words
+    // are distinct), so that's checked along with the offsets.  Each word
+    // is only looked at once the offsets around it have been checked.
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (offsets[i] > offsets[i + 1] || offsets[i + 1] > header.textSize)
+        {
+            throw BinaryDictionaryException{path + " is truncated or corrupt"};
+        }
+
+        if (isSorted() && i > 0 && !(word(i - 1) < word(i)))
+        {
+            throw BinaryDictionaryException{path + " is marked sorted, but its words are not ascending"};
+        }
+    }
+
+    if (offsets[0] != 0 || offsets[count] != header.textSize)
+    {
+        throw BinaryDictionaryException{path + " is truncated or corrupt"};
+    }
+}
+
+
+unsigned int BinaryDictionary::size() const noexcept
+{
+    return count;
+}
+
+
+bool BinaryDictionary::isSorted() const noexcept
+{
+    return (flags & SORTED) != 0;
+}
+
+
+std::string_view BinaryDictionary::word(unsigned int i) const noexcept
+{
+    return std::string_view{text + offsets[i], offsets[i + 1] - offsets[i]};
+}
+
+
+unsigned int BinaryDictionary::wordHash(unsigned int i) const noexcept
+{
+    return hashes[i];
+}
+
+
+std::vector<std::string_view> BinaryDictionary::sortedWords() const
+{
+    std::vector<std::string_view> words(count);
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        words[i] = word(i);
+    }
+
+    if (!isSorted())
+    {
+        std::sort(words.begin(), words.end());
+    }
+
+    return words;
+}
+
+
+void BinaryDictionary::loadInto(HashSet<std::string>& set, unsigned int threadCount) const
+{
+    set.assignUnique(
+        count,
+        [this](unsigned int i) { return word(i); },
+        [this](unsigned int i) { return hashes[i]; },
+        resolveThreadCount(threadCount));
+
+    // The HashSet's hash function can't be compared to hash(), but if
+    // it's a different one, words will have been put where it won't look
+    // for them, which a few lookups will almost certainly notice.  Those
+    // words are taken out again before saying so.
+    for (unsigned int i = 0; i < count; i += count / 8 + 1)
+    {
+        if (!set.contains(std::string{word(i)}))
+        {
+            set.assignUnique(0, [](unsigned int) { return std::string{}; }, [](unsigned int) { return 0u; });
+
+            throw BinaryDictionaryException{"The HashSet does not use BinaryDictionary::hash()"};
+        }
+    }
+}
+
+
+void BinaryDictionary::loadInto(AVLSet<std::string>& set, unsigned int threadCount) const
+{
+    std::vector<std::string_view> words = sortedWords();
+    set.assignSorted(words.begin(), words.end(), resolveThreadCount(threadCount));
+}
+
+
+unsigned int BinaryDictionary::resolveThreadCount(unsigned int threadCount) noexcept
+{
+    return threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+}
@@ -0,0 +1,188 @@
+// BinaryDictionary.hpp
+//
+// A BinaryDictionary is a word list stored in a compact binary file that
+// can be loaded without parsing, and from which a HashSet, an AVLSet, or
+// a SkipListSet can be built in bulk, rather than a word at a time.
+//
+// The file is laid out as follows, with every integer in the byte order
+// of the machine that wrote it:
+//
+//     "WORDDICT"            8 bytes, identifying the format
+//     version               4 bytes (currently 1)
+//     flags                 4 bytes (bit 0 set if the words are sorted)
+//     word count (n)        4 bytes
+//     reserved              4 bytes (zero)
+//     text size             8 bytes
+//     offsets               4 * (n + 1) bytes
+//     hashes                4 * n bytes
+//     text                  all of the words, one after another
+//
+// The i-th word is the text from offsets[i] up to offsets[i + 1], and
+// hashes[i] is its hash as computed by BinaryDictionary::hash(), so a
+// HashSet that uses that hash function never needs to hash a word as
+// it's loaded.  The words are distinct; when the file says they're
+// sorted, reading it checks that they're in strictly ascending order.
+
+#ifndef BINARYDICTIONARY_HPP
+#define BINARYDICTIONARY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "AVLSet.hpp"
+#include "HashSet.hpp"
+#include "SkipListSet.hpp"
+
+
+
+// BinaryDictionaryExceptions are thrown when a BinaryDictionary can't be
+// read or written, or when its contents don't make sense.
+
+class BinaryDictionaryException : public std::runtime_error
+{
+public:
+    explicit BinaryDictionaryException(const std::string& reason);
+};
+
+
+
+class BinaryDictionary
+{
+public:
+    // write() writes the given words to a binary dictionary file with the
+    // given path, after removing duplicates and, if asked to, sorting them.
+    static void write(const std::string& path, std::vector<std::string> words, bool sort = true);
+
+
+    // hash() is the hash function whose results are stored in the file.
+    // HashSets that are built from a BinaryDictionary must use it.
+    static unsigned int hash(const std::string& word) noexcept;
+    static unsigned int hash(std::string_view word) noexcept;
+
+
+public:
+    // Reads the binary dictionary file with the given path into memory,
+    // in one piece.
+    explicit BinaryDictionary(const std::string& path);
+
+
+    // size() returns the number of words in the dictionary.
+    unsigned int size() const noexcept;
+
+
+    // isSorted() returns true if the words are stored in ascending order.
+    bool isSorted() const noexcept;
+
+
+    // word() returns the i-th word, which remains valid as long as the
+    // BinaryDictionary does.
+    std::string_view word(unsigned int i) const noexcept;
+
+
+    // wordHash() returns the stored hash of the i-th word.
+    unsigned int wordHash(unsigned int i) const noexcept;
+
+
+    // sortedWords() returns all of the words in ascending order, sorting
+    // them first if they weren't stored that way.
+    std::vector<std::string_view> sortedWords() const;
+
+
+    // loadInto() replaces the contents of the given set with the words in
+    // the dictionary, using up to the given number of threads (or one per
+    // core, if it's zero).  The HashSet must use BinaryDictionary::hash()
+    // as its hash function; a BinaryDictionaryException is thrown if it
+    // evidently doesn't, in which case it's left empty.
+    void loadInto(HashSet<std::string>& set, unsigned int threadCount = 0) const;
+    void loadInto(AVLSet<std::string>& set, unsigned int threadCount = 0) const;
+
+    template <bool Indexed>
+    void loadInto(SkipListSet<std::string, Indexed>& set, unsigned int threadCount = 0) const;
+
+
+private:
+    static unsigned int resolveThreadCount(unsigned int threadCount) noexcept;
+
+private:
+    std::unique_ptr<char[]> contents;
+    unsigned int count;
+    std::uint32_t flags;
+    const std::uint32_t* offsets;
+    const std::uint32_t* hashes;
+    const char* text;
+};
+
+
+
+inline BinaryDictionaryException::BinaryDictionaryException(const std::string& reason)
+    : std::runtime_error{reason}
+{
+}
+
+
+
+template <bool Indexed>
+void BinaryDictionary::loadInto(SkipListSet<std::string, Indexed>& set, unsigned int threadCount) const
+{
+    // A SkipListSet is built by appending one tower at a time, so that
+    // part can't be split up, but making the strings it copies can.
+    std::vector<std::string_view> sorted = sortedWords();
+    std::vector<std::string> words(sorted.size());
+
+    threadCount = resolveThreadCount(threadCount);
+
+    // A failed allocation on any thread is caught there, and the first
+    // one is thrown again once every thread has finished, leaving the set
+    // as it was.
+    std::vector<std::exception_ptr> failures(threadCount);
+
+    auto makeWords =
+        [&](unsigned int t)
+        {
+            try
+            {
+                for (std::size_t i = words.size() * t / threadCount; i < words.size() * (t + 1) / threadCount; ++i)
+                {
+                    words[i].assign(sorted[i]);
+                }
+            }
+            catch (...)
+            {
+                failures[t] = std::current_exception();
+            }
+        };
+
+    std::vector<std::thread> threads;
+
+    for (unsigned int t = 1; t < threadCount; ++t)
+    {
+        threads.emplace_back(makeWords, t);
+    }
+
+    makeWords(0);
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (std::exception_ptr& failure : failures)
+    {
+        if (failure)
+        {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    set.assignSorted(words.begin(), words.end());
+}
+
+
+
+#endif
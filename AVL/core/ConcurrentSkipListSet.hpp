@@ -0,0 +1,834 @@
+// ConcurrentSkipListSet.hpp
+//
+// A ConcurrentSkipListSet is an ordered set that many threads can add to,
+// remove from, search, and iterate at the same time without any locks.
+// It follows the lock-free skip list described by Fraser and by Herlihy
+// and Shavit: the low bit of each forward pointer is a "mark" that says
+// the node owning that pointer is being removed, and every change to the
+// structure is a single compare-and-swap on one forward pointer.
+//
+// Removed nodes can't be deallocated the moment they're unlinked, since
+// another thread might be standing on one of them.  Instead, they're
+// handed to an epoch-based reclamation scheme (impl_::EpochDomain, below),
+// which deallocates them only once every thread that might have seen them
+// has finished the operation it was in the middle of.
+
+#ifndef CONCURRENTSKIPLISTSET_HPP
+#define CONCURRENTSKIPLISTSET_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <random>
+#include <vector>
+#include "Set.hpp"
+
+
+
+namespace impl_
+{
+    // An EpochDomain tracks a global epoch number and, for each thread
+    // that has used it, the epoch that thread observed when it entered
+    // its current operation (or zero if it's not in the middle of one).
+    // Objects retired during epoch e are deallocated once the global epoch
+    // has reached e + 2, at which point no thread can still be using them.
+    // There is one domain shared by every ConcurrentSkipListSet.
+    class EpochDomain
+    {
+    public:
+        using Deleter = void (*)(void*);
+
+        static EpochDomain& instance();
+
+        ~EpochDomain() noexcept;
+
+        // enter() and exit() bracket an operation that reads shared
+        // pointers.  They may be nested.
+        void enter();
+        void exit() noexcept;
+
+        // retire() schedules an object, already unreachable from the
+        // shared structure, to be deallocated with the given deleter.
+        // It must be called between enter() and exit().
+        void retire(void* object, Deleter deleter);
+
+    private:
+        static constexpr unsigned int RETIRED_PER_SCAN = 64;
+
+        struct Retired
+        {
+            void* object;
+            Deleter deleter;
+        };
+
+        struct alignas(64) Record
+        {
+            std::atomic<std::uint64_t> epoch{0};
+            std::atomic<bool> owned{true};
+            Record* next = nullptr;
+
+            unsigned int nesting = 0;
+            unsigned int retiredSinceScan = 0;
+            std::uint64_t bucketEpochs[3] = {0, 0, 0};
+            std::vector<Retired> buckets[3];
+        };
+
+        // Each thread's record is released, though not deallocated, when
+        // the thread ends; the next new thread adopts it, along with
+        // anything that was still waiting in its buckets.
+        struct RecordHandle
+        {
+            Record* record = nullptr;
+            ~RecordHandle() noexcept;
+        };
+
+        EpochDomain() = default;
+
+        Record& threadRecord();
+        bool tryAdvance(std::uint64_t epoch) noexcept;
+        static void reclaim(std::vector<Retired>& bucket) noexcept;
+        static void reclaimExpired(Record& record, std::uint64_t epoch) noexcept;
+
+        std::atomic<std::uint64_t> globalEpoch{1};
+        std::atomic<Record*> records{nullptr};
+    };
+
+
+    // An EpochGuard enters the shared EpochDomain for as long as it lives.
+    class EpochGuard
+    {
+    public:
+        EpochGuard();
+        ~EpochGuard() noexcept;
+
+        EpochGuard(const EpochGuard&) = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+    };
+
+
+
+    inline EpochDomain& EpochDomain::instance()
+    {
+        static EpochDomain domain;
+        return domain;
+    }
+
+
+    inline EpochDomain::~EpochDomain() noexcept
+    {
+        Record* record = records.load();
+
+        while (record != nullptr)
+        {
+            Record* next = record->next;
+
+            for (std::vector<Retired>& bucket : record->buckets)
+            {
+                reclaim(bucket);
+            }
+
+            delete record;
+            record = next;
+        }
+    }
+
+
+    inline EpochDomain::RecordHandle::~RecordHandle() noexcept
+    {
+        if (record != nullptr)
+        {
+            record->epoch.store(0);
+            record->owned.store(false);
+        }
+    }
+
+
+    inline EpochDomain::Record& EpochDomain::threadRecord()
+    {
+        thread_local RecordHandle handle;
+
+        if (handle.record != nullptr)
+        {
+            return *handle.record;
+        }
+
+        for (Record* r = records.load(); r != nullptr; r = r->next)
+        {
+            bool expected = false;
+
+            if (!r->owned.load() && r->owned.compare_exchange_strong(expected, true))
+            {
+                handle.record = r;
+                return *r;
+            }
+        }
+
+        Record* r = new Record;
+        r->next = records.load();
+
+        while (!records.compare_exchange_weak(r->next, r))
+        {
+        }
+
+        handle.record = r;
+        return *r;
+    }
+
+
+    inline void EpochDomain::enter()
+    {
+        Record& record = threadRecord();
+
+        if (record.nesting++ == 0)
+        {
+            record.epoch.store(globalEpoch.load());
+        }
+    }
+
+
+    inline void EpochDomain::exit() noexcept
+    {
+        Record& record = threadRecord();
+
+        if (--record.nesting == 0)
+        {
+            record.epoch.store(0);
+        }
+    }
+
+
+    inline void EpochDomain::retire(void* object, Deleter deleter)
+    {
+        Record& record = threadRecord();
+
+        // The object became unreachable no later than now, so the epoch
+        // read here is the one that has to pass before deallocating it.
+        std::uint64_t epoch = globalEpoch.load();
+        unsigned int index = epoch % 3;
+
+        if (record.bucketEpochs[index] != epoch)
+        {
+            // Anything still in this bucket is from epoch - 3 or earlier.
+            reclaim(record.buckets[index]);
+            record.bucketEpochs[index] = epoch;
+        }
+
+        record.buckets[index].push_back(Retired{object, deleter});
+
+        if (++record.retiredSinceScan >= RETIRED_PER_SCAN)
+        {
+            record.retiredSinceScan = 0;
+
+            tryAdvance(epoch);
+            reclaimExpired(record, globalEpoch.load());
+        }
+    }
+
+
+    inline bool EpochDomain::tryAdvance(std::uint64_t epoch) noexcept
+    {
+        for (Record* r = records.load(); r != nullptr; r = r->next)
+        {
+            std::uint64_t observed = r->epoch.load();
+
+            if (observed != 0 && observed != epoch)
+            {
+                return false;
+            }
+        }
+
+        return globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+
+    inline void EpochDomain::reclaim(std::vector<Retired>& bucket) noexcept
+    {
+        for (const Retired& retired : bucket)
+        {
+            retired.deleter(retired.object);
+        }
+
+        bucket.clear();
+    }
+
+
+    inline void EpochDomain::reclaimExpired(Record& record, std::uint64_t epoch) noexcept
+    {
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            if (record.bucketEpochs[i] + 2 <= epoch)
+            {
+                reclaim(record.buckets[i]);
+            }
+        }
+    }
+
+
+    inline EpochGuard::EpochGuard()
+    {
+        EpochDomain::instance().enter();
+    }
+
+
+    inline EpochGuard::~EpochGuard() noexcept
+    {
+        EpochDomain::instance().exit();
+    }
+}
+
+
+
+template <typename ElementType>
+class ConcurrentSkipListSet : public Set<ElementType>
+{
+public:
+    // A VisitFunction is a function that takes a reference to a const
+    // ElementType and returns no value.
+    using VisitFunction = std::function<void(const ElementType&)>;
+
+    // The most levels any element will occupy.  With a one-in-two chance
+    // of occupying each next level, this comfortably covers any set that
+    // fits in memory.
+    static constexpr unsigned int MAX_LEVELS = 32;
+
+public:
+    // Initializes a ConcurrentSkipListSet to be empty.
+    ConcurrentSkipListSet();
+
+    // Cleans up the ConcurrentSkipListSet so that it leaks no memory.
+    // No other thread may be using the set while it's being destroyed.
+    ~ConcurrentSkipListSet() noexcept override;
+
+    // ConcurrentSkipListSets are shared between threads by reference,
+    // so they can be neither copied nor moved.
+    ConcurrentSkipListSet(const ConcurrentSkipListSet& s) = delete;
+    ConcurrentSkipListSet& operator=(const ConcurrentSkipListSet& s) = delete;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  It is safe to call concurrently
+    // with any of the other member functions and runs in an expected time
+    // of O(log n), plus any retries caused by contention.
+    void add(const ElementType& element) override;
+
+
+    // remove() removes an element from the set, returning true if it was
+    // this call that removed it, false if it wasn't in the set.  It is safe
+    // to call concurrently with any of the other member functions.
+    bool remove(const ElementType& element);
+
+
+    // contains() returns true if the given element is in the set, false
+    // otherwise.  It never writes to the shared structure and never
+    // retries, so it completes in a bounded number of steps regardless of
+    // what other threads are doing.
+    bool contains(const ElementType& element) const override;
+
+
+    // size() returns the number of elements in the set.  While other
+    // threads are adding or removing elements, this is only a snapshot.
+    unsigned int size() const noexcept override;
+
+
+    // forEach() calls the given "visit" function for each of the elements
+    // in the set, in ascending order.  Elements added or removed while the
+    // iteration is in progress may or may not be visited, but no element
+    // is visited twice and none that was present throughout is skipped.
+    void forEach(VisitFunction visit) const;
+
+
+private:
+    // As in SkipListSet, each element is a single allocation holding its
+    // key followed by an inline tower of forward pointers.  Each forward
+    // pointer is stored as an integer whose low bit is the mark.  The head
+    // and tail sentinels have full-height towers and no key.
+    struct Node
+    {
+        Node() noexcept {}
+        ~Node() noexcept {}
+
+        union
+        {
+            ElementType key;
+        };
+
+        unsigned int height;
+
+        // A removed node is retired by whichever of its adder and its
+        // remover finishes with it last; see finishWith().
+        std::atomic<int> owners;
+    };
+
+    using Link = std::atomic<std::uintptr_t>;
+
+    static Node* createNode(unsigned int height);
+    static Node* createNode(const ElementType& element, unsigned int height);
+    static void destroyNode(void* node) noexcept;
+    static Link* forward(const Node* node) noexcept;
+
+    static Node* pointerOf(std::uintptr_t link) noexcept;
+    static bool isMarked(std::uintptr_t link) noexcept;
+    static std::uintptr_t linkTo(const Node* node, bool marked = false) noexcept;
+
+    static unsigned int randomHeight();
+
+    bool find(const ElementType& element, Node** preds, Node** succs) const;
+    void finishWith(Node* node);
+
+private:
+    Node* head;
+    Node* tail;
+    std::atomic<unsigned int> sz;
+};
+
+
+
+template <typename ElementType>
+typename ConcurrentSkipListSet<ElementType>::Node* ConcurrentSkipListSet<ElementType>::createNode(
+    unsigned int height)
+{
+    void* memory = ::operator new(
+        (sizeof(Node) + sizeof(Link) - 1) / sizeof(Link) * sizeof(Link)
+        + height * sizeof(Link));
+
+    Node* node = new (memory) Node;
+    node->height = height;
+    node->owners.store(2, std::memory_order_relaxed);
+
+    for (unsigned int level = 0; level < height; ++level)
+    {
+        new (forward(node) + level) Link{0};
+    }
+
+    return node;
+}
+
+
+template <typename ElementType>
+typename ConcurrentSkipListSet<ElementType>::Node* ConcurrentSkipListSet<ElementType>::createNode(
+    const ElementType& element, unsigned int height)
+{
+    Node* node = createNode(height);
+
+    try
+    {
+        new (&node->key) ElementType{element};
+    }
+    catch (...)
+    {
+        node->~Node();
+        ::operator delete(node);
+        throw;
+    }
+
+    return node;
+}
+
+
+template <typename ElementType>
+void ConcurrentSkipListSet<ElementType>::destroyNode(void* node) noexcept
+{
+    Node* n = static_cast<Node*>(node);
+    n->key.~ElementType();
+    n->~Node();
+    ::operator delete(n);
+}
+
+
+template <typename ElementType>
+typename ConcurrentSkipListSet<ElementType>::Link* ConcurrentSkipListSet<ElementType>::forward(
+    const Node* node) noexcept
+{
+    return reinterpret_cast<Link*>(
+        const_cast<char*>(reinterpret_cast<const char*>(node))
+        + (sizeof(Node) + sizeof(Link) - 1) / sizeof(Link) * sizeof(Link));
+}
+
+
+template <typename ElementType>
+typename ConcurrentSkipListSet<ElementType>::Node* ConcurrentSkipListSet<ElementType>::pointerOf(
+    std::uintptr_t link) noexcept
+{
+    return reinterpret_cast<Node*>(link & ~std::uintptr_t{1});
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::isMarked(std::uintptr_t link) noexcept
+{
+    return (link & 1) != 0;
+}
+
+
+template <typename ElementType>
+std::uintptr_t ConcurrentSkipListSet<ElementType>::linkTo(const Node* node, bool marked) noexcept
+{
+    return reinterpret_cast<std::uintptr_t>(node) | (marked ? 1 : 0);
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::randomHeight()
+{
+    // Level testers aren't thread-safe, so each thread flips its own coins.
+    thread_local std::default_random_engine engine{std::random_device{}()};
+    thread_local std::bernoulli_distribution distribution{0.5};
+
+    unsigned int height = 1;
+
+    while (height < MAX_LEVELS && distribution(engine))
+    {
+        ++height;
+    }
+
+    return height;
+}
+
+
+// find() fills preds and succs with, on each level, the last node whose
+// key is less than the given element and the node after it, unlinking
+// any marked nodes it passes along the way.  It returns true if the
+// element was found (unmarked) on level 0.
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::find(
+    const ElementType& element, Node** preds, Node** succs) const
+{
+retry:
+    Node* pred = head;
+    Node* curr = nullptr;
+
+    for (unsigned int level = MAX_LEVELS; level-- > 0; )
+    {
+        curr = pointerOf(forward(pred)[level].load());
+
+        while (curr != tail)
+        {
+            std::uintptr_t succ = forward(curr)[level].load();
+
+            while (isMarked(succ))
+            {
+                std::uintptr_t expected = linkTo(curr);
+
+                if (!forward(pred)[level].compare_exchange_strong(expected, linkTo(pointerOf(succ))))
+                {
+                    goto retry;
+                }
+
+                curr = pointerOf(succ);
+
+                if (curr == tail)
+                {
+                    break;
+                }
+
+                succ = forward(curr)[level].load();
+            }
+
+            if (curr == tail || !(curr->key < element))
+            {
+                break;
+            }
+
+            pred = curr;
+            curr = pointerOf(succ);
+        }
+
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+
+    return curr != tail && curr->key == element;
+}
+
+
+// finishWith() is called once by a node's adder, when it's done linking
+// the node's tower, and once by its remover, when it's done unlinking it.
+// Only after both is it certain that no level still links to the node.
+
+template <typename ElementType>
+void ConcurrentSkipListSet<ElementType>::finishWith(Node* node)
+{
+    if (node->owners.fetch_sub(1) == 1)
+    {
+        impl_::EpochDomain::instance().retire(node, &destroyNode);
+    }
+}
+
+
+
+template <typename ElementType>
+ConcurrentSkipListSet<ElementType>::ConcurrentSkipListSet()
+    : head{createNode(MAX_LEVELS)}, tail{nullptr}, sz{0}
+{
+    try
+    {
+        tail = createNode(MAX_LEVELS);
+    }
+    catch (...)
+    {
+        head->~Node();
+        ::operator delete(head);
+        throw;
+    }
+
+    for (unsigned int level = 0; level < MAX_LEVELS; ++level)
+    {
+        forward(head)[level].store(linkTo(tail));
+    }
+}
+
+
+template <typename ElementType>
+ConcurrentSkipListSet<ElementType>::~ConcurrentSkipListSet() noexcept
+{
+    // Every node still linked on level 0 belongs to the set; every node
+    // that has been unlinked already belongs to the EpochDomain.
+    Node* current = pointerOf(forward(head)[0].load());
+
+    while (current != tail)
+    {
+        Node* next = pointerOf(forward(current)[0].load());
+        destroyNode(current);
+        current = next;
+    }
+
+    head->~Node();
+    ::operator delete(head);
+
+    tail->~Node();
+    ::operator delete(tail);
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void ConcurrentSkipListSet<ElementType>::add(const ElementType& element)
+{
+    impl_::EpochGuard guard;
+
+    Node* preds[MAX_LEVELS];
+    Node* succs[MAX_LEVELS];
+
+    unsigned int height = randomHeight();
+    Node* node = nullptr;
+
+    while (true)
+    {
+        if (find(element, preds, succs))
+        {
+            if (node != nullptr)
+            {
+                destroyNode(node);
+            }
+
+            return;
+        }
+
+        if (node == nullptr)
+        {
+            node = createNode(element, height);
+        }
+
+        for (unsigned int level = 0; level < height; ++level)
+        {
+            forward(node)[level].store(linkTo(succs[level]), std::memory_order_relaxed);
+        }
+
+        // Linking level 0 is what makes the element part of the set.
+        std::uintptr_t expected = linkTo(succs[0]);
+
+        if (forward(preds[0])[0].compare_exchange_strong(expected, linkTo(node)))
+        {
+            break;
+        }
+    }
+
+    sz.fetch_add(1);
+
+    bool linking = true;
+
+    for (unsigned int level = 1; linking && level < height; ++level)
+    {
+        while (true)
+        {
+            // Point the new node at its successor on this level first,
+            // unless a remover has marked it, in which case there's no
+            // sense linking it any higher.
+            std::uintptr_t next = forward(node)[level].load();
+
+            if (isMarked(next))
+            {
+                linking = false;
+                break;
+            }
+
+            if (pointerOf(next) != succs[level]
+                && !forward(node)[level].compare_exchange_strong(next, linkTo(succs[level])))
+            {
+                continue;
+            }
+
+            std::uintptr_t expected = linkTo(succs[level]);
+
+            if (forward(preds[level])[level].compare_exchange_strong(expected, linkTo(node)))
+            {
+                break;
+            }
+
+            find(element, preds, succs);
+
+            if (succs[0] != node)
+            {
+                // Already removed from level 0 by someone else.
+                linking = false;
+                break;
+            }
+        }
+    }
+
+    // If a remover marked the node while it was being linked, its own
+    // find() may have run before the last link was made, so clean up
+    // after ourselves before letting go.
+    if (isMarked(forward(node)[0].load()))
+    {
+        find(element, preds, succs);
+    }
+
+    finishWith(node);
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::remove(const ElementType& element)
+{
+    impl_::EpochGuard guard;
+
+    Node* preds[MAX_LEVELS];
+    Node* succs[MAX_LEVELS];
+
+    if (!find(element, preds, succs))
+    {
+        return false;
+    }
+
+    Node* node = succs[0];
+
+    // Mark the upper levels top-down; it doesn't matter who wins these.
+    for (unsigned int level = node->height; level-- > 1; )
+    {
+        std::uintptr_t next = forward(node)[level].load();
+
+        while (!isMarked(next))
+        {
+            forward(node)[level].compare_exchange_weak(next, next | 1);
+        }
+    }
+
+    // Marking level 0 is what removes the element from the set, so only
+    // one remover can succeed.
+    std::uintptr_t next = forward(node)[0].load();
+
+    while (true)
+    {
+        if (isMarked(next))
+        {
+            return false;
+        }
+
+        if (forward(node)[0].compare_exchange_weak(next, next | 1))
+        {
+            break;
+        }
+    }
+
+    sz.fetch_sub(1);
+
+    find(element, preds, succs);
+    finishWith(node);
+
+    return true;
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::contains(const ElementType& element) const
+{
+    impl_::EpochGuard guard;
+
+    Node* pred = head;
+    Node* curr = nullptr;
+
+    for (unsigned int level = MAX_LEVELS; level-- > 0; )
+    {
+        curr = pointerOf(forward(pred)[level].load());
+
+        while (curr != tail)
+        {
+            std::uintptr_t succ = forward(curr)[level].load();
+
+            // Step over marked nodes rather than unlinking them.
+            while (isMarked(succ))
+            {
+                curr = pointerOf(succ);
+
+                if (curr == tail)
+                {
+                    break;
+                }
+
+                succ = forward(curr)[level].load();
+            }
+
+            if (curr == tail || !(curr->key < element))
+            {
+                break;
+            }
+
+            pred = curr;
+            curr = pointerOf(succ);
+        }
+    }
+
+    return curr != tail && curr->key == element && !isMarked(forward(curr)[0].load());
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::size() const noexcept
+{
+    return sz.load();
+}
+
+
+template <typename ElementType>
+void ConcurrentSkipListSet<ElementType>::forEach(VisitFunction visit) const
+{
+    impl_::EpochGuard guard;
+
+    for (Node* current = pointerOf(forward(head)[0].load()); current != tail; )
+    {
+        std::uintptr_t next = forward(current)[0].load();
+
+        if (!isMarked(next))
+        {
+            visit(current->key);
+        }
+
+        current = pointerOf(next);
+    }
+}
+
+
+
+#endif
@@ -0,0 +1,314 @@
+// DeletionIndex.cpp
+
+#include <algorithm>
+#include "DeletionIndex.hpp"
+#include "Levenshtein.hpp"
+
+
+DeletionIndex::DeletionIndex(std::vector<std::string> words, unsigned int maxDistance)
+    : maxDist{maxDistance}, words{std::move(words)}
+{
+    std::sort(this->words.begin(), this->words.end());
+    this->words.erase(std::unique(this->words.begin(), this->words.end()), this->words.end());
+
+    // Every (deletion, word) pair is listed, then sorted so that the
+    // words for each deletion are together; making the same deletion
+    // from a word in more than one way lists it more than once.
+    std::vector<std::pair<std::uint64_t, unsigned int>> pairs;
+
+    for (unsigned int id = 0; id < this->words.size(); ++id)
+    {
+        forEachDeletion(
+            this->words[id], maxDist,
+            [&](std::uint64_t h)
+            {
+                pairs.emplace_back(h, id);
+            });
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    std::size_t distinct = 0;
+
+    for (std::size_t i = 0; i < pairs.size(); ++i)
+    {
+        if (i == 0 || pairs[i].first != pairs[i - 1].first)
+        {
+            ++distinct;
+        }
+    }
+
+    hashes.reserve(distinct);
+    firstWord.reserve(distinct + 1);
+    wordIds.reserve(pairs.size());
+
+    for (const auto& [h, id] : pairs)
+    {
+        if (hashes.empty() || hashes.back() != h)
+        {
+            hashes.push_back(h);
+            firstWord.push_back(wordIds.size());
+        }
+
+        wordIds.push_back(id);
+    }
+
+    firstWord.push_back(wordIds.size());
+
+    pairs.clear();
+    pairs.shrink_to_fit();
+
+    std::size_t slots = 1;
+
+    while (slots < hashes.size() * 2)
+    {
+        slots *= 2;
+    }
+
+    table.assign(slots, EMPTY);
+
+    for (unsigned int i = 0; i < hashes.size(); ++i)
+    {
+        std::size_t slot = hashes[i] & (slots - 1);
+
+        while (table[slot] != EMPTY)
+        {
+            slot = (slot + 1) & (slots - 1);
+        }
+
+        table[slot] = i;
+    }
+}
+
+
+std::vector<std::pair<std::string, unsigned int>> DeletionIndex::findWithin(
+    std::string_view word, unsigned int distance) const
+{
+    distance = std::min(distance, maxDist);
+
+    // A word within the given distance shares a string with this one
+    // that both can be made from by deleting at most that many
+    // characters, so making that many deletions from this one finds it.
+    std::vector<unsigned int> candidates;
+
+    forEachDeletion(
+        word, distance,
+        [&](std::uint64_t h)
+        {
+            unsigned int i = find(h);
+
+            if (i != EMPTY)
+            {
+                candidates.insert(
+                    candidates.end(), wordIds.begin() + firstWord[i], wordIds.begin() + firstWord[i + 1]);
+            }
+        });
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    LevenshteinMatcher matcher{word};
+    std::vector<std::pair<std::string, unsigned int>> found;
+
+    for (unsigned int id : candidates)
+    {
+        unsigned int d = matcher.distance(words[id], distance);
+
+        if (d <= distance)
+        {
+            found.emplace_back(words[id], d);
+        }
+    }
+
+    // The candidates were in alphabetical order, so a stable sort by
+    // distance leaves them that way among equals.
+    std::stable_sort(
+        found.begin(), found.end(),
+        [](const auto& a, const auto& b)
+        {
+            return a.second < b.second;
+        });
+
+    return found;
+}
+
+
+std::vector<std::string> DeletionIndex::findSuggestions(const std::string& word) const
+{
+    std::vector<std::string> suggestions;
+
+    for (auto& [suggestion, distance] : findWithin(word, maxDist))
+    {
+        suggestions.push_back(std::move(suggestion));
+    }
+
+    impl_::addSplits(word, [this](std::string_view s) { return contains(s); }, suggestions);
+
+    return suggestions;
+}
+
+
+bool DeletionIndex::contains(std::string_view word) const
+{
+    return std::binary_search(words.begin(), words.end(), word);
+}
+
+
+unsigned int DeletionIndex::size() const noexcept
+{
+    return words.size();
+}
+
+
+unsigned int DeletionIndex::maxDistance() const noexcept
+{
+    return maxDist;
+}
+
+
+unsigned int DeletionIndex::deletionCount() const noexcept
+{
+    return hashes.size();
+}
+
+
+std::size_t DeletionIndex::memoryUsage() const noexcept
+{
+    std::size_t bytes = sizeof(*this)
+        + words.capacity() * sizeof(std::string)
+        + hashes.capacity() * sizeof(std::uint64_t)
+        + firstWord.capacity() * sizeof(unsigned int)
+        + wordIds.capacity() * sizeof(unsigned int)
+        + table.capacity() * sizeof(unsigned int);
+
+    for (const std::string& word : words)
+    {
+        // Short strings are stored inside the std::string itself.
+        if (word.capacity() > std::string{}.capacity())
+        {
+            bytes += word.capacity() + 1;
+        }
+    }
+
+    return bytes;
+}
+
+
+template <typename Function>
+void DeletionIndex::forEachDeletion(std::string_view word, unsigned int maxDeletions, Function function)
+{
+    // Deletions are made breadth-first, one more character at a time;
+    // each level's deletions are only made from the previous level's
+    // distinct strings.  All of a level's strings are the same length, so
+    // they're stored back to back in one scratch string and made distinct
+    // by sorting their positions.  The scratch buffers belong to the
+    // thread, so once they've grown, making deletions allocates nothing.
+    thread_local std::string level;
+    thread_local std::string next;
+    thread_local std::vector<unsigned int> order;
+
+    level.assign(word);
+    function(hash(word));
+
+    for (std::size_t length = word.size(), deletions = 1;
+         deletions <= maxDeletions && length > 0;
+         --length, ++deletions)
+    {
+        // Any string of length 1 leaves only the empty string.
+        if (length == 1)
+        {
+            function(hash(std::string_view{}));
+            break;
+        }
+
+        next.clear();
+
+        for (std::size_t start = 0; start < level.size(); start += length)
+        {
+            std::string_view s{level.data() + start, length};
+
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                // Deleting any character in a run of equal ones gives the
+                // same string, so only the first of each run is deleted.
+                if (i > 0 && s[i] == s[i - 1])
+                {
+                    continue;
+                }
+
+                next.append(s.substr(0, i));
+                next.append(s.substr(i + 1));
+            }
+        }
+
+        std::size_t nextLength = length - 1;
+        auto deletion =
+            [&](unsigned int position)
+            {
+                return std::string_view{next.data() + position * nextLength, nextLength};
+            };
+
+        order.resize(next.size() / nextLength);
+
+        for (unsigned int position = 0; position < order.size(); ++position)
+        {
+            order[position] = position;
+        }
+
+        std::sort(
+            order.begin(), order.end(),
+            [&](unsigned int a, unsigned int b)
+            {
+                return deletion(a) < deletion(b);
+            });
+
+        level.clear();
+
+        for (std::size_t k = 0; k < order.size(); ++k)
+        {
+            std::string_view d = deletion(order[k]);
+
+            if (k == 0 || d != deletion(order[k - 1]))
+            {
+                level.append(d);
+                function(hash(d));
+            }
+        }
+    }
+}
+
+
+std::uint64_t DeletionIndex::hash(std::string_view s) noexcept
+{
+    // 64-bit FNV-1a, with a final mix so that the low bits (which pick a
+    // slot in the table) depend on every character.
+    std::uint64_t h = 14695981039346656037ull;
+
+    for (char c : s)
+    {
+        h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+
+    h ^= h >> 32;
+    h *= 0xd6e8feb86659fd93ull;
+    h ^= h >> 32;
+
+    return h;
+}
+
+
+unsigned int DeletionIndex::find(std::uint64_t hash) const noexcept
+{
+    std::size_t mask = table.size() - 1;
+
+    for (std::size_t slot = hash & mask; table[slot] != EMPTY; slot = (slot + 1) & mask)
+    {
+        if (hashes[table[slot]] == hash)
+        {
+            return table[slot];
+        }
+    }
+
+    return EMPTY;
+}
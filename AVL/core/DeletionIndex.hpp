@@ -0,0 +1,112 @@
+// DeletionIndex.hpp
+//
+// A DeletionIndex is a SymSpell-style SuggestionEngine: it finds every
+// word in the dictionary within a given edit distance (up to 2, by
+// default) of a misspelled one, without generating the enormous number
+// of strings within that distance of it.
+//
+// The idea is that if two words are within edit distance k, then some
+// string made by deleting at most k characters from one is also made by
+// deleting at most k characters from the other.  So the index maps every
+// such "deletion" of every dictionary word back to the words it came
+// from.  To find suggestions, the same deletions are made from the
+// misspelled word and looked up, which gives a small set of candidates;
+// each is then checked with a LevenshteinMatcher, since sharing a
+// deletion is necessary but not sufficient.
+//
+// Only a 64-bit hash of each deletion is stored, not the deletion itself.
+// A collision can only add a candidate, which checking then throws out,
+// so it costs time but never correctness.  The hashes are kept in one
+// sorted array, with the words for each stored contiguously, and a
+// separate open-addressing table finds a hash's position in the array.
+
+#ifndef DELETIONINDEX_HPP
+#define DELETIONINDEX_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "SuggestionEngine.hpp"
+
+
+
+class DeletionIndex : public SuggestionEngine
+{
+public:
+    // Builds a DeletionIndex that can find words within the given edit
+    // distance of the given words, which can be in any order and can
+    // contain duplicates.
+    explicit DeletionIndex(std::vector<std::string> words, unsigned int maxDistance = 2);
+
+
+    // findWithin() returns the words within the given edit distance
+    // (which can't be more than the index's maximum) of the given word,
+    // along with their distances, nearest first and alphabetically among
+    // words at the same distance.
+    std::vector<std::pair<std::string, unsigned int>> findWithin(
+        std::string_view word, unsigned int distance) const;
+
+
+    // findSuggestions() returns the words within the index's maximum edit
+    // distance of the given word, nearest first, followed by the word's
+    // splits into two words (see addSplits() in SuggestionEngine.hpp).
+    std::vector<std::string> findSuggestions(const std::string& word) const override;
+
+
+    // contains() returns true if the given word is in the dictionary.
+    bool contains(std::string_view word) const;
+
+
+    // size() returns the number of distinct words in the dictionary.
+    unsigned int size() const noexcept;
+
+
+    // maxDistance() returns the largest edit distance that the index can
+    // find words within.
+    unsigned int maxDistance() const noexcept;
+
+
+    // deletionCount() returns the number of distinct deletions (or, more
+    // precisely, distinct hashes of them) that the index maps to words.
+    unsigned int deletionCount() const noexcept;
+
+
+    // memoryUsage() returns the approximate number of bytes used by the
+    // index, including the words themselves.
+    std::size_t memoryUsage() const noexcept;
+
+
+private:
+    static constexpr unsigned int EMPTY = static_cast<unsigned int>(-1);
+
+    // Calls the given function with the hash of every distinct string
+    // made by deleting up to maxDeletions characters from the given word.
+    template <typename Function>
+    static void forEachDeletion(std::string_view word, unsigned int maxDeletions, Function function);
+
+    static std::uint64_t hash(std::string_view s) noexcept;
+
+    // Returns the position of the given hash in hashes, or EMPTY.
+    unsigned int find(std::uint64_t hash) const noexcept;
+
+private:
+    unsigned int maxDist;
+
+    // The dictionary, sorted.
+    std::vector<std::string> words;
+
+    // The distinct hashes of deletions, sorted.  The words that the i-th
+    // one came from are wordIds[firstWord[i]] up to wordIds[firstWord[i + 1]].
+    std::vector<std::uint64_t> hashes;
+    std::vector<unsigned int> firstWord;
+    std::vector<unsigned int> wordIds;
+
+    // An open-addressing hash table (with linear probing) of positions in
+    // hashes, or EMPTY.  Its size is a power of two.
+    std::vector<unsigned int> table;
+};
+
+
+
+#endif
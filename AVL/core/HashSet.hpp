@@ -3,7 +3,11 @@
 #ifndef HASHSET_HPP
 #define HASHSET_HPP
  
+#include <algorithm>
+#include <exception>
 #include <functional>
+#include <thread>
+#include <vector>
 #include "Set.hpp"
  
  
@@ -81,6 +85,22 @@ public:
    // particular index in the array, false otherwise.  If the index is
    // out of the boundaries of the array, this functions returns false.
    bool isElementAtIndex(const ElementType& element, unsigned int index) const;
+
+
+   // assignUnique() replaces the contents of the set with count elements
+   // that are known to be distinct, where elementAt(i) returns the i-th
+   // one (or anything an ElementType can be constructed from) and hashAt(i)
+   // returns its hash, which must be what the set's hash function would
+   // return for it.  The capacity is chosen up front, so nothing is ever
+   // rehashed, and no element is compared to any other.  Each element is
+   // hashed once, and the array is split among the given number of
+   // threads, each of which adds only the elements that hash into its own
+   // part of it.  If elementAt() or hashAt() throws, or memory runs out,
+   // the set is left empty and the exception is thrown again here.
+   template <typename ElementAt, typename HashAt>
+   void assignUnique(unsigned int count, ElementAt elementAt, HashAt hashAt, unsigned int threadCount = 1);
+
+
    void initializeTable();
    void rehash(const ElementType& element);
  
@@ -98,7 +118,8 @@ private:
    unsigned int cap;
    unsigned int sz;
    Node** setHash;
- 
+
+   void destroyNodes() noexcept;
  
     // You'll no doubt want to add member variables and "helper" member
    // functions here.
@@ -141,20 +162,27 @@ void HashSet<ElementType>::initializeTable()
 template <typename ElementType>
 HashSet<ElementType>::~HashSet() noexcept
 {
+    destroyNodes();
+    delete[] setHash;
+}
+
 
-     for (int i = 0 ; i<cap; i++)
+template <typename ElementType>
+void HashSet<ElementType>::destroyNodes() noexcept
+{
+    for (unsigned int i = 0; i < cap; i++)
     {
-       Node *current = setHash[i];
-       Node *prev = nullptr;
-       while (current != nullptr)
-       {
-           prev = current->next;
-           delete current;
-           current = prev;
-       }
-   }
-   delete[] setHash;
+        Node* current = setHash[i];
+
+        while (current != nullptr)
+        {
+            Node* next = current->next;
+            delete current;
+            current = next;
+        }
 
+        setHash[i] = nullptr;
+    }
 }
 
 
@@ -272,31 +300,35 @@ bool HashSet<ElementType>::isImplemented() const noexcept
 template <typename ElementType>
 void HashSet<ElementType>::rehash(const ElementType& element)
 {
-            int newCap = ((cap*2)+1);
-            Node** newTable = new Node*[newCap];
+    // The existing nodes are moved into the new array, rather than copied,
+    // so nothing is allocated but the array.
+    unsigned int newCap = cap * 2 + 1;
+    Node** newTable = new Node*[newCap];
 
-            for (int i = 0; i< newCap; i++)
-            {
-                newTable[i] = nullptr;
-            }
+    for (unsigned int i = 0; i < newCap; i++)
+    {
+        newTable[i] = nullptr;
+    }
 
-            int a = 0;
-            while (a<cap)
-                {
-                    Node* prevElement = setHash[a];
+    for (unsigned int a = 0; a < cap; a++)
+    {
+        Node* current = setHash[a];
 
-                    while(prevElement != nullptr)
-                    {
-                        int newkeyIndex = hashFunction(prevElement->element) % newCap;
-                        newTable[newkeyIndex] = new Node{prevElement->element,newTable[newkeyIndex]};
-                        prevElement = prevElement->next;
-                    }
-                    a++;
-                }
+        while (current != nullptr)
+        {
+            Node* next = current->next;
+            unsigned int newKeyIndex = hashFunction(current->element) % newCap;
 
-            setHash = newTable;
-            cap = newCap;
+            current->next = newTable[newKeyIndex];
+            newTable[newKeyIndex] = current;
 
+            current = next;
+        }
+    }
+
+    delete[] setHash;
+    setHash = newTable;
+    cap = newCap;
 }
 
 
@@ -327,6 +359,154 @@ void HashSet<ElementType>::add(const ElementType& element)
 
 
 
+template <typename ElementType>
+template <typename ElementAt, typename HashAt>
+void HashSet<ElementType>::assignUnique(
+    unsigned int count, ElementAt elementAt, HashAt hashAt, unsigned int threadCount)
+{
+    destroyNodes();
+
+    // Large enough that add() won't need to rehash right away either.
+    unsigned int newCap = count / 4 * 5 + DEFAULT_CAPACITY;
+
+    if (newCap != cap)
+    {
+        Node** newTable = new Node*[newCap];
+        delete[] setHash;
+        setHash = newTable;
+        cap = newCap;
+        initializeTable();
+    }
+
+    sz = 0;
+
+    threadCount = std::max(1u, std::min(threadCount, count / 1024 + 1));
+
+    // The work is done in three passes, each split among the threads,
+    // so that every element is hashed only once:
+    //
+    // 1. Each thread hashes its share of the elements, noting each one's
+    //    slot and counting how many fall into each thread's part of the
+    //    array.
+    // 2. Each thread moves its share of the elements' indices into one
+    //    array, grouped by the part of the array they fall into.
+    // 3. Each thread adds the elements in its own part of the array.
+    //
+    // An exception thrown on any thread (by elementAt(), hashAt(), or a
+    // failed allocation) is caught there, and the first one is thrown
+    // again once every thread has finished.
+    std::vector<unsigned int> slots(count);
+    std::vector<unsigned int> grouped(count);
+    std::vector<std::vector<unsigned int>> positions(threadCount, std::vector<unsigned int>(threadCount, 0));
+    std::vector<std::exception_ptr> failures(threadCount);
+
+    auto firstOf =
+        [](unsigned int total, unsigned int t, unsigned int threadCount)
+        {
+            return static_cast<unsigned int>(static_cast<unsigned long long>(total) * t / threadCount);
+        };
+
+    auto partOf =
+        [&](unsigned int slot)
+        {
+            return static_cast<unsigned int>(static_cast<unsigned long long>(slot) * threadCount / cap);
+        };
+
+    auto runOnThreads =
+        [&](auto pass)
+        {
+            auto guarded =
+                [&](unsigned int t)
+                {
+                    try
+                    {
+                        pass(t);
+                    }
+                    catch (...)
+                    {
+                        failures[t] = std::current_exception();
+                    }
+                };
+
+            std::vector<std::thread> threads;
+
+            for (unsigned int t = 1; t < threadCount; t++)
+            {
+                threads.emplace_back(guarded, t);
+            }
+
+            guarded(0);
+
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            for (std::exception_ptr& failure : failures)
+            {
+                if (failure)
+                {
+                    destroyNodes();
+                    std::rethrow_exception(failure);
+                }
+            }
+        };
+
+    runOnThreads(
+        [&](unsigned int t)
+        {
+            for (unsigned int i = firstOf(count, t, threadCount); i < firstOf(count, t + 1, threadCount); i++)
+            {
+                slots[i] = hashAt(i) % cap;
+                ++positions[t][partOf(slots[i])];
+            }
+        });
+
+    // The counts become the positions in "grouped" where each thread's
+    // elements for each part go, parts first, then threads, so that
+    // every part's indices are in ascending order.
+    unsigned int position = 0;
+
+    for (unsigned int part = 0; part < threadCount; part++)
+    {
+        for (unsigned int t = 0; t < threadCount; t++)
+        {
+            unsigned int elements = positions[t][part];
+            positions[t][part] = position;
+            position += elements;
+        }
+    }
+
+    runOnThreads(
+        [&](unsigned int t)
+        {
+            for (unsigned int i = firstOf(count, t, threadCount); i < firstOf(count, t + 1, threadCount); i++)
+            {
+                grouped[positions[t][partOf(slots[i])]++] = i;
+            }
+        });
+
+    // After the second pass, positions[threadCount - 1][part] is where
+    // the part's indices end, and the previous part's end is where they
+    // begin.
+    runOnThreads(
+        [&](unsigned int part)
+        {
+            unsigned int first = part > 0 ? positions[threadCount - 1][part - 1] : 0;
+            unsigned int last = positions[threadCount - 1][part];
+
+            for (unsigned int g = first; g < last; g++)
+            {
+                unsigned int i = grouped[g];
+                setHash[slots[i]] = new Node{ElementType(elementAt(i)), setHash[slots[i]]};
+            }
+        });
+
+    sz = count;
+}
+
+
+
 template <typename ElementType>
 bool HashSet<ElementType>::contains(const ElementType& element) const
 {
@@ -0,0 +1,139 @@
+// Levenshtein.cpp
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "Levenshtein.hpp"
+
+
+LevenshteinMatcher::LevenshteinMatcher(std::string_view pattern)
+    : pat{pattern}, positions{}
+{
+    if (pat.size() <= MAX_BIT_PARALLEL_LENGTH)
+    {
+        for (std::size_t i = 0; i < pat.size(); ++i)
+        {
+            positions[static_cast<unsigned char>(pat[i])] |= std::uint64_t{1} << i;
+        }
+    }
+}
+
+
+unsigned int LevenshteinMatcher::distance(std::string_view text) const
+{
+    if (pat.size() <= MAX_BIT_PARALLEL_LENGTH)
+    {
+        return bitParallelDistance(text);
+    }
+    else
+    {
+        return tableDistance(text);
+    }
+}
+
+
+unsigned int LevenshteinMatcher::distance(std::string_view text, unsigned int limit) const
+{
+    // The distance is at least the difference in lengths, since that
+    // many characters have to be inserted or deleted, whatever else.
+    std::size_t difference = pat.size() > text.size()
+        ? pat.size() - text.size() : text.size() - pat.size();
+
+    if (difference > limit)
+    {
+        return difference;
+    }
+
+    return distance(text);
+}
+
+
+const std::string& LevenshteinMatcher::pattern() const noexcept
+{
+    return pat;
+}
+
+
+// In the table, row i and column j hold the distance between the first
+// i characters of the pattern and the first j characters of the text.
+// Here, a column is represented by its first entry (j), its last entry
+// (the score), and, for the rows in between, bits saying which entries
+// are one more than the one above (positiveVertical) or one less
+// (negativeVertical); adjacent entries never differ by more than one.
+
+unsigned int LevenshteinMatcher::bitParallelDistance(std::string_view text) const noexcept
+{
+    if (pat.empty())
+    {
+        return text.size();
+    }
+
+    std::uint64_t lastRow = std::uint64_t{1} << (pat.size() - 1);
+    std::uint64_t positiveVertical = ~std::uint64_t{0};
+    std::uint64_t negativeVertical = 0;
+    unsigned int score = pat.size();
+
+    for (char c : text)
+    {
+        std::uint64_t matches = positions[static_cast<unsigned char>(c)];
+        std::uint64_t verticalChange = matches | negativeVertical;
+        std::uint64_t horizontalChange =
+            (((matches & positiveVertical) + positiveVertical) ^ positiveVertical) | matches;
+
+        std::uint64_t positiveHorizontal = negativeVertical | ~(horizontalChange | positiveVertical);
+        std::uint64_t negativeHorizontal = positiveVertical & horizontalChange;
+
+        if (positiveHorizontal & lastRow)
+        {
+            ++score;
+        }
+        else if (negativeHorizontal & lastRow)
+        {
+            --score;
+        }
+
+        // The entry in the first row always goes up by one from column to
+        // column, which is the one shifted in here.
+        positiveHorizontal = (positiveHorizontal << 1) | 1;
+        negativeHorizontal <<= 1;
+
+        positiveVertical = negativeHorizontal | ~(verticalChange | positiveHorizontal);
+        negativeVertical = positiveHorizontal & verticalChange;
+    }
+
+    return score;
+}
+
+
+unsigned int LevenshteinMatcher::tableDistance(std::string_view text) const
+{
+    std::vector<unsigned int> row(text.size() + 1);
+    std::iota(row.begin(), row.end(), 0u);
+
+    for (std::size_t i = 1; i <= pat.size(); ++i)
+    {
+        unsigned int diagonal = row[0];
+        row[0] = i;
+
+        for (std::size_t j = 1; j <= text.size(); ++j)
+        {
+            unsigned int above = row[j];
+
+            row[j] = std::min({
+                above + 1,
+                row[j - 1] + 1,
+                diagonal + (pat[i - 1] == text[j - 1] ? 0 : 1)});
+
+            diagonal = above;
+        }
+    }
+
+    return row[text.size()];
+}
+
+
+
+unsigned int levenshteinDistance(std::string_view a, std::string_view b)
+{
+    return LevenshteinMatcher{a}.distance(b);
+}
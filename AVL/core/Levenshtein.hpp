@@ -0,0 +1,69 @@
+// Levenshtein.hpp
+//
+// A LevenshteinMatcher measures the Levenshtein (edit) distance between
+// one fixed word (the "pattern") and any number of others: the fewest
+// insertions, deletions, and replacements of single characters that turn
+// one into the other.
+//
+// For patterns of up to 64 characters, it uses Myers' bit-parallel
+// algorithm, in which each column of the usual dynamic programming table
+// is kept as two bit vectors (which rows go up by one from the row above,
+// and which go down by one), so a whole column is computed with a dozen
+// operations on 64-bit integers.  The per-character bit masks this needs
+// are built once, when the matcher is constructed, so comparing a word
+// against many candidates only pays for that once.  Longer patterns fall
+// back to the table, one row at a time.
+
+#ifndef LEVENSHTEIN_HPP
+#define LEVENSHTEIN_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+
+
+class LevenshteinMatcher
+{
+public:
+    explicit LevenshteinMatcher(std::string_view pattern);
+
+
+    // distance() returns the edit distance between the pattern and the
+    // given text.
+    unsigned int distance(std::string_view text) const;
+
+
+    // distance() with a limit returns the edit distance between the
+    // pattern and the given text, or any value larger than the limit if
+    // the distance is larger than that, which can be decided early.
+    unsigned int distance(std::string_view text, unsigned int limit) const;
+
+
+    // pattern() returns the word that the matcher was constructed with.
+    const std::string& pattern() const noexcept;
+
+
+private:
+    static constexpr std::size_t MAX_BIT_PARALLEL_LENGTH = 64;
+
+    unsigned int bitParallelDistance(std::string_view text) const noexcept;
+    unsigned int tableDistance(std::string_view text) const;
+
+private:
+    std::string pat;
+
+    // For each character, the bit mask of the positions in the pattern
+    // at which it occurs.  Only used for short enough patterns.
+    std::array<std::uint64_t, 256> positions;
+};
+
+
+
+// levenshteinDistance() returns the edit distance between two strings.
+unsigned int levenshteinDistance(std::string_view a, std::string_view b);
+
+
+
+#endif
@@ -0,0 +1,246 @@
+// LevenshteinAutomaton.cpp
+
+#include <algorithm>
+#include <limits>
+#include "LevenshteinAutomaton.hpp"
+
+
+LevenshteinAutomaton::LevenshteinAutomaton(std::string_view word, unsigned int maxDistance)
+    : word{word}, maxDistance{std::min(maxDistance, 254u)}
+{
+    // Strings compare their characters as unsigned chars, so the alphabet
+    // is sorted the same way; a plain char may be signed.
+    alphabet = this->word;
+    std::sort(
+        alphabet.begin(), alphabet.end(),
+        [](char a, char b)
+        {
+            return static_cast<unsigned char>(a) < static_cast<unsigned char>(b);
+        });
+
+    alphabet.erase(std::unique(alphabet.begin(), alphabet.end()), alphabet.end());
+
+    characterClass.fill(alphabet.size());
+
+    for (unsigned int i = 0; i < alphabet.size(); ++i)
+    {
+        characterClass[static_cast<unsigned char>(alphabet[i])] = i;
+    }
+
+    // The dead state is numbered first, so that it's always DEAD.
+    stateFor(std::vector<unsigned char>(this->word.size() + 1, this->maxDistance + 1));
+
+    std::vector<unsigned char> first(this->word.size() + 1);
+
+    for (std::size_t j = 0; j < first.size(); ++j)
+    {
+        first[j] = std::min<std::size_t>(j, this->maxDistance + 1);
+    }
+
+    stateFor(first);
+}
+
+
+LevenshteinAutomaton::State LevenshteinAutomaton::start() const noexcept
+{
+    // The row for the empty string is numbered right after the dead one.
+    return 1;
+}
+
+
+LevenshteinAutomaton::State LevenshteinAutomaton::next(State state, char c) const
+{
+    unsigned int cls = characterClass[static_cast<unsigned char>(c)];
+    std::size_t index = state * (alphabet.size() + 1) + cls;
+
+    if (transitions[index] != UNKNOWN)
+    {
+        return transitions[index];
+    }
+
+    const unsigned char cap = maxDistance + 1;
+    std::vector<unsigned char> row(word.size() + 1);
+
+    // rows can be reallocated by stateFor(), so no reference into it is
+    // kept while the new row is being worked out.
+    {
+        const std::vector<unsigned char>& previous = rows[state];
+
+        row[0] = std::min<unsigned int>(previous[0] + 1, cap);
+
+        for (std::size_t j = 1; j < row.size(); ++j)
+        {
+            unsigned int replaced = previous[j - 1] + (word[j - 1] == c ? 0 : 1);
+            unsigned int inserted = previous[j] + 1;
+            unsigned int deleted = row[j - 1] + 1;
+
+            row[j] = std::min<unsigned int>({replaced, inserted, deleted, cap});
+        }
+    }
+
+    State reached = stateFor(row);
+    transitions[state * (alphabet.size() + 1) + cls] = reached;
+
+    return reached;
+}
+
+
+bool LevenshteinAutomaton::isAccepting(State state) const noexcept
+{
+    return rows[state].back() <= maxDistance;
+}
+
+
+unsigned int LevenshteinAutomaton::distance(State state) const noexcept
+{
+    return rows[state].back();
+}
+
+
+bool LevenshteinAutomaton::accepts(std::string_view s) const
+{
+    State state = start();
+
+    for (std::size_t i = 0; i < s.size() && state != DEAD; ++i)
+    {
+        state = next(state, s[i]);
+    }
+
+    return isAccepting(state);
+}
+
+
+std::optional<std::string> LevenshteinAutomaton::nextMatch(std::string_view s) const
+{
+    // Follow s as far as possible, remembering the state before each
+    // character.
+    std::vector<State> path{start()};
+
+    for (std::size_t i = 0; i < s.size() && path.back() != DEAD; ++i)
+    {
+        path.push_back(next(path.back(), s[i]));
+    }
+
+    if (path.size() == s.size() + 1 && isAccepting(path.back()))
+    {
+        return std::string{s};
+    }
+
+    // Otherwise, the answer shares the longest possible prefix with s,
+    // then has a larger character than s does; or, if s was followed all
+    // the way to a live state, it's an extension of s.  Either way, from
+    // there on it's the smallest accepted string, found by always
+    // following the smallest live character until reaching an accepting
+    // state.  Every live state can reach one, and the first entry of the
+    // row grows with every character, so this never goes on for long.
+    std::size_t length = path.size() - 1;
+    std::optional<char> after;
+
+    if (path.back() == DEAD)
+    {
+        path.pop_back();
+        --length;
+        after = s[length];
+    }
+
+    while (true)
+    {
+        std::optional<char> c = nextLiveCharacter(path.back(), after);
+
+        if (c)
+        {
+            std::string match{s.substr(0, length)};
+            match += *c;
+
+            State state = next(path.back(), *c);
+
+            while (!isAccepting(state))
+            {
+                char smallest = *nextLiveCharacter(state, std::nullopt);
+                match += smallest;
+                state = next(state, smallest);
+            }
+
+            return match;
+        }
+
+        if (length == 0)
+        {
+            return std::nullopt;
+        }
+
+        path.pop_back();
+        --length;
+        after = s[length];
+    }
+}
+
+
+unsigned int LevenshteinAutomaton::stateCount() const noexcept
+{
+    return rows.size();
+}
+
+
+LevenshteinAutomaton::State LevenshteinAutomaton::stateFor(const std::vector<unsigned char>& row) const
+{
+    auto [found, added] = states.emplace(row, rows.size());
+
+    if (added)
+    {
+        rows.push_back(row);
+        transitions.resize(rows.size() * (alphabet.size() + 1), UNKNOWN);
+
+        // The dead state leads only to itself.
+        if (found->second == DEAD)
+        {
+            std::fill(transitions.begin(), transitions.end(), DEAD);
+        }
+    }
+
+    return found->second;
+}
+
+
+std::optional<char> LevenshteinAutomaton::nextLiveCharacter(State state, std::optional<char> after) const
+{
+    // The candidates are the word's characters, in order, and the
+    // smallest character that isn't one of them, which stands for all of
+    // those.
+    unsigned int first = after ? static_cast<unsigned char>(*after) + 1 : 0;
+
+    if (first > std::numeric_limits<unsigned char>::max())
+    {
+        return std::nullopt;
+    }
+
+    unsigned int other = first;
+
+    while (other <= std::numeric_limits<unsigned char>::max() && characterClass[other] != alphabet.size())
+    {
+        ++other;
+    }
+
+    for (char c : alphabet)
+    {
+        unsigned int u = static_cast<unsigned char>(c);
+
+        if (other < u && other <= std::numeric_limits<unsigned char>::max()
+            && next(state, static_cast<char>(other)) != DEAD)
+        {
+            return static_cast<char>(other);
+        }
+
+        if (u >= first && next(state, c) != DEAD)
+        {
+            return c;
+        }
+    }
+
+    if (other <= std::numeric_limits<unsigned char>::max() && next(state, static_cast<char>(other)) != DEAD)
+    {
+        return static_cast<char>(other);
+    }
+
+    return std::nullopt;
+}
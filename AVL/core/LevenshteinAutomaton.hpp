@@ -0,0 +1,116 @@
+// LevenshteinAutomaton.hpp
+//
+// A LevenshteinAutomaton is a deterministic finite automaton that accepts
+// exactly the strings within a given edit distance of a given word.
+//
+// Each state is a row of the usual dynamic programming table for edit
+// distance: after reading a string s, entry j is the distance between s
+// and the first j characters of the word, except that anything larger
+// than the maximum distance is recorded as one more than it, since the
+// difference no longer matters.  That makes the number of distinct rows
+// finite, and small; they're numbered as they're first reached, and the
+// transitions between them are worked out only when they're first
+// followed, so building the automaton costs nothing up front.
+//
+// Every character that doesn't appear in the word has the same effect on
+// a row, so the transitions only need to distinguish the word's distinct
+// characters and "anything else".
+//
+// Because every state either is dead (no entry within the distance) or
+// can still reach an accepting state, nextMatch() can find the smallest
+// accepted string that isn't less than a given one, which lets the
+// automaton skip over whole ranges of a sorted dictionary at a time.
+
+#ifndef LEVENSHTEINAUTOMATON_HPP
+#define LEVENSHTEINAUTOMATON_HPP
+
+#include <array>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class LevenshteinAutomaton
+{
+public:
+    using State = unsigned int;
+
+    // DEAD is the state from which nothing can be accepted anymore.
+    static constexpr State DEAD = 0;
+
+
+public:
+    LevenshteinAutomaton(std::string_view word, unsigned int maxDistance);
+
+
+    // start() returns the state before anything has been read.
+    State start() const noexcept;
+
+
+    // next() returns the state reached from the given one by reading the
+    // given character.
+    State next(State state, char c) const;
+
+
+    // isAccepting() returns true if the string read to reach the given
+    // state is within the maximum distance of the word.
+    bool isAccepting(State state) const noexcept;
+
+
+    // distance() returns the edit distance between the word and the
+    // string read to reach the given accepting state.
+    unsigned int distance(State state) const noexcept;
+
+
+    // accepts() returns true if the given string is within the maximum
+    // distance of the word.
+    bool accepts(std::string_view s) const;
+
+
+    // nextMatch() returns the smallest string, in lexicographic order,
+    // that the automaton accepts and that isn't less than the given one,
+    // or nothing if there isn't one.
+    std::optional<std::string> nextMatch(std::string_view s) const;
+
+
+    // stateCount() returns the number of states reached so far, including
+    // the dead state.
+    unsigned int stateCount() const noexcept;
+
+
+private:
+    static constexpr State UNKNOWN = static_cast<State>(-1);
+
+    // Returns the state numbered for the given row, numbering it if it
+    // hasn't been reached before.
+    State stateFor(const std::vector<unsigned char>& row) const;
+
+    // Returns the smallest character greater than the given one (or any
+    // character, if there's no given one) that doesn't lead from the given
+    // state to the dead state, or nothing if there isn't one.
+    std::optional<char> nextLiveCharacter(State state, std::optional<char> after) const;
+
+private:
+    std::string word;
+    unsigned int maxDistance;
+
+    // The word's distinct characters, in ascending order as unsigned
+    // chars; the "anything else" class comes after them.
+    std::string alphabet;
+    std::array<unsigned int, 256> characterClass;
+
+    // Everything below is filled in lazily, as states are reached.
+    mutable std::vector<std::vector<unsigned char>> rows;
+    mutable std::map<std::vector<unsigned char>, State> states;
+
+    // transitions[state * (alphabet.size() + 1) + class] is UNKNOWN until
+    // it's first followed.
+    mutable std::vector<State> transitions;
+};
+
+
+
+#endif
@@ -4,201 +4,234 @@
 #ifndef SKIPLISTSET_HPP
 #define SKIPLISTSET_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <memory>
-#include <optional>
+#include <new>
 #include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 #include "Set.hpp"
 
 
 
 
-// SkipListKind indicates a kind of key: a normal one, the special key
-// -INF, or the special key +INF.  It's necessary for us to implement
-// the notion of -INF and +INF separately, since we're building a class
-// template and not all types of keys would have a reasonable notion of
-// -INF and +INF.
-
-enum class SkipListKind
-{
-    Normal,
-    NegInf,
-    PosInf
-};
-
-
-
-
-// A SkipListKey represents a single key in a skip list.  It is possible
-// to compare these keys using < or == operators (which are overloaded here)
-// and those comparisons respect the notion of whether each key is normal,
-// -INF, or +INF.
+// The SkipListLevelTester class represents the ability to decide whether
+// a key placed on one level of the skip list should also occupy the next
+// level.  This is the "coin flip," so to speak.  Note that this is an
+// abstract base class with one implementation, RandomSkipListLevelTester,
+// just below it.  RandomSkipListLevelTester is what it sounds like: It
+// makes the decision at random (with a 50/50 chance of deciding whether
+// a key should occupy the next level).  However, by setting things up
+// this way, we have a way to control things more carefully in our
+// testing (as you can, as well).
+//
+// DO NOT MAKE CHANGES TO THE SIGNATURES OF THE MEMBER FUNCTIONS OF
+// THE "level tester" CLASSES.  You can add new member functions or even
+// whole new level tester classes, but the ones declared below are part
+// of how we test your implementation, so they need to maintain the
+// parts of the interface that are declared already.
 
 template <typename ElementType>
-class SkipListKey
+class SkipListLevelTester
 {
 public:
-    static SkipListKey normal(const ElementType& element);
-    static SkipListKey negInf();
-    static SkipListKey posInf();
-
-    bool operator==(const SkipListKey& other) const;
-    bool operator==(const ElementType& other) const;
-
-    bool operator<(const SkipListKey& other) const;
-    bool operator<(const ElementType& other) const;
+    virtual ~SkipListLevelTester() = default;
 
-private:
-    SkipListKey(SkipListKind kind, std::optional<ElementType> element);
+    virtual bool shouldOccupyNextLevel(const ElementType& element) = 0;
+    virtual std::unique_ptr<SkipListLevelTester<ElementType>> clone() = 0;
 
-private:
-    SkipListKind kind;
-    std::optional<ElementType> element;
+    // levelFor() decides, all at once, the highest level a newly-added
+    // key should occupy (0 meaning only the bottom level).  By default,
+    // it flips coins with shouldOccupyNextLevel() until one comes up
+    // false, but a level tester can override it to decide more cheaply.
+    virtual unsigned int levelFor(const ElementType& element);
 };
 
 
 template <typename ElementType>
-SkipListKey<ElementType> SkipListKey<ElementType>::normal(const ElementType& element)
+unsigned int SkipListLevelTester<ElementType>::levelFor(const ElementType& element)
 {
-    return SkipListKey{SkipListKind::Normal, std::make_optional(element)};
-}
+    unsigned int level = 0;
 
+    while (shouldOccupyNextLevel(element))
+    {
+        ++level;
+    }
 
-template <typename ElementType>
-SkipListKey<ElementType> SkipListKey<ElementType>::negInf()
-{
-    return SkipListKey{SkipListKind::NegInf, std::nullopt};
+    return level;
 }
 
 
 template <typename ElementType>
-SkipListKey<ElementType> SkipListKey<ElementType>::posInf()
+class RandomSkipListLevelTester : public SkipListLevelTester<ElementType>
 {
-    return SkipListKey{SkipListKind::PosInf, std::nullopt};
-}
+public:
+    RandomSkipListLevelTester();
 
+    bool shouldOccupyNextLevel(const ElementType& element) override;
+    std::unique_ptr<SkipListLevelTester<ElementType>> clone() override;
 
-template <typename ElementType>
-SkipListKey<ElementType>::SkipListKey(SkipListKind kind, std::optional<ElementType> element)
-    : kind{kind}, element{element}
-{
-}
+private:
+    std::default_random_engine engine;
+    std::bernoulli_distribution distribution;
+};
 
 
 template <typename ElementType>
-bool SkipListKey<ElementType>::operator==(const SkipListKey& other) const
+RandomSkipListLevelTester<ElementType>::RandomSkipListLevelTester()
+    : engine{std::random_device{}()}, distribution{0.5}
 {
-    return kind == other.kind
-        && (kind != SkipListKind::Normal || *element == *other.element);
 }
 
 
 template <typename ElementType>
-bool SkipListKey<ElementType>::operator==(const ElementType& other) const
+bool RandomSkipListLevelTester<ElementType>::shouldOccupyNextLevel(const ElementType& element)
 {
-    return kind == SkipListKind::Normal && *element == other;
+    return distribution(engine);
 }
 
 
 template <typename ElementType>
-bool SkipListKey<ElementType>::operator<(const SkipListKey& other) const
+std::unique_ptr<SkipListLevelTester<ElementType>> RandomSkipListLevelTester<ElementType>::clone()
 {
-    switch (kind)
-    {
-    case SkipListKind::NegInf:
-        return other.kind != SkipListKind::NegInf;
+    return std::unique_ptr<SkipListLevelTester<ElementType>>{
+        new RandomSkipListLevelTester<ElementType>};
+}
 
-    case SkipListKind::PosInf:
-        return false;
 
-    default: // SkipListKind::Normal
-        return other.kind == SkipListKind::PosInf
-            || (other.kind == SkipListKind::Normal && *element < *other.element);
-    }
-}
 
+// A GeometricSkipListLevelTester decides a key's level from a single
+// 64-bit draw of a SplitMix64 generator, rather than one coin flip per
+// level.  Each level is occupied with the given promotion probability,
+// up to a maximum level.  When that probability is 1/2, 1/4, 1/8, and so
+// on, the level is just the number of trailing zero bits in the draw
+// divided by log2(1/p); otherwise, the draw is turned into a uniform
+// number u in (0, 1] and the level is floor(log(u) / log(p)).  As with
+// shouldOccupyNextLevel(), a probability of 0 or less never promotes a
+// key, and a probability of 1 or more always promotes it to maxLevel.
 
 template <typename ElementType>
-bool SkipListKey<ElementType>::operator<(const ElementType& other) const
+class GeometricSkipListLevelTester : public SkipListLevelTester<ElementType>
 {
-    return kind == SkipListKind::NegInf
-        || (kind == SkipListKind::Normal && *element < other);
-}
+public:
+    explicit GeometricSkipListLevelTester(
+        double promotionProbability = 0.5, unsigned int maxLevel = 31);
 
+    bool shouldOccupyNextLevel(const ElementType& element) override;
+    std::unique_ptr<SkipListLevelTester<ElementType>> clone() override;
+    unsigned int levelFor(const ElementType& element) override;
 
+private:
+    std::uint64_t nextRandom() noexcept;
 
-// The SkipListLevelTester class represents the ability to decide whether
-// a key placed on one level of the skip list should also occupy the next
-// level.  This is the "coin flip," so to speak.  Note that this is an
-// abstract base class with one implementation, RandomSkipListLevelTester,
-// just below it.  RandomSkipListLevelTester is what it sounds like: It
-// makes the decision at random (with a 50/50 chance of deciding whether
-// a key should occupy the next level).  However, by setting things up
-// this way, we have a way to control things more carefully in our
-// testing (as you can, as well).
-//
-// DO NOT MAKE CHANGES TO THE SIGNATURES OF THE MEMBER FUNCTIONS OF
-// THE "level tester" CLASSES.  You can add new member functions or even
-// whole new level tester classes, but the ones declared below are part
-// of how we test your implementation, so they need to maintain the
-// parts of the interface that are declared already.
+private:
+    double promotionProbability;
+    unsigned int maxLevel;
 
-template <typename ElementType>
-class SkipListLevelTester
-{
-public:
-    virtual ~SkipListLevelTester() = default;
+    // log2(1 / promotionProbability) when that's a whole number, else 0.
+    unsigned int bitsPerLevel;
+    double logProbability;
 
-    virtual bool shouldOccupyNextLevel(const ElementType& element) = 0;
-    virtual std::unique_ptr<SkipListLevelTester<ElementType>> clone() = 0;
+    std::uint64_t state;
 };
 
 
 template <typename ElementType>
-class RandomSkipListLevelTester : public SkipListLevelTester<ElementType>
+GeometricSkipListLevelTester<ElementType>::GeometricSkipListLevelTester(
+    double promotionProbability, unsigned int maxLevel)
+    : promotionProbability{promotionProbability}, maxLevel{maxLevel},
+      bitsPerLevel{0}, logProbability{std::log(promotionProbability)},
+      state{(std::uint64_t{std::random_device{}()} << 32) | std::random_device{}()}
 {
-public:
-    RandomSkipListLevelTester();
+    for (unsigned int bits = 1; bits < 64; ++bits)
+    {
+        if (std::ldexp(1.0, -static_cast<int>(bits)) == promotionProbability)
+        {
+            bitsPerLevel = bits;
+            break;
+        }
+    }
+}
 
-    bool shouldOccupyNextLevel(const ElementType& element) override;
-    std::unique_ptr<SkipListLevelTester<ElementType>> clone() override;
 
-private:
-    std::default_random_engine engine;
-    std::bernoulli_distribution distribution;
-};
+template <typename ElementType>
+bool GeometricSkipListLevelTester<ElementType>::shouldOccupyNextLevel(const ElementType&)
+{
+    return (nextRandom() >> 11) * 0x1.0p-53 < promotionProbability;
+}
 
 
 template <typename ElementType>
-RandomSkipListLevelTester<ElementType>::RandomSkipListLevelTester()
-    : engine{std::random_device{}()}, distribution{0.5}
+std::unique_ptr<SkipListLevelTester<ElementType>> GeometricSkipListLevelTester<ElementType>::clone()
 {
+    return std::unique_ptr<SkipListLevelTester<ElementType>>{
+        new GeometricSkipListLevelTester<ElementType>{promotionProbability, maxLevel}};
 }
 
 
 template <typename ElementType>
-bool RandomSkipListLevelTester<ElementType>::shouldOccupyNextLevel(const ElementType& element)
+unsigned int GeometricSkipListLevelTester<ElementType>::levelFor(const ElementType&)
 {
-    return distribution(engine);
+    std::uint64_t draw = nextRandom();
+    unsigned int level;
+
+    if (bitsPerLevel != 0)
+    {
+        // The top bit is forced on so that a draw of zero still has a
+        // well-defined number of trailing zeros.
+        level = __builtin_ctzll(draw | (std::uint64_t{1} << 63)) / bitsPerLevel;
+    }
+    else if (!(promotionProbability > 0.0))
+    {
+        level = 0;
+    }
+    else if (promotionProbability >= 1.0)
+    {
+        level = maxLevel;
+    }
+    else
+    {
+        double u = ((draw >> 11) + 1) * 0x1.0p-53;
+        double logLevel = std::log(u) / logProbability;
+        level = logLevel < maxLevel ? static_cast<unsigned int>(logLevel) : maxLevel;
+    }
+
+    return std::min(level, maxLevel);
 }
 
 
 template <typename ElementType>
-std::unique_ptr<SkipListLevelTester<ElementType>> RandomSkipListLevelTester<ElementType>::clone()
+std::uint64_t GeometricSkipListLevelTester<ElementType>::nextRandom() noexcept
 {
-    return std::unique_ptr<SkipListLevelTester<ElementType>>{
-        new RandomSkipListLevelTester<ElementType>};
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
 }
 
 
 
 
-template <typename ElementType>
+// A SkipListSet can optionally store, along with each forward pointer,
+// the "width" of that link (i.e., how many elements it skips over, plus
+// one).  Summing widths on the way down gives the position of any tower
+// in the skip list, which is what makes rank(), select(), and eraseAt()
+// possible in expected O(log n) time.  Since widths cost memory and time
+// that most sets don't need, they're stored only when the Indexed type
+// parameter is true.
+
+template <typename ElementType, bool Indexed = false>
 class SkipListSet : public Set<ElementType>
 {
 public:
     // Initializes an SkipListSet to be empty, with or without a
     // "level tester" object that will decide, whenever a "coin flip"
     // is needed, whether a key should occupy the next level above.
+    // Without one, a GeometricSkipListLevelTester with a 50/50 chance
+    // of occupying each next level is used.
     SkipListSet();
     explicit SkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester);
 
@@ -231,6 +264,14 @@ public:
     void add(const ElementType& element) override;
 
 
+    // assignSorted() replaces the contents of the set with the elements
+    // in the range [first, last), which must be in ascending order
+    // (adjacent duplicates are skipped).  Since every element is simply
+    // appended after the one before it, this runs in O(n) time.
+    template <typename InputIterator>
+    void assignSorted(InputIterator first, InputIterator last);
+
+
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function runs in an expected time of O(log n)
     // (i.e., over the long run, we expect the average to be O(log n))
@@ -242,6 +283,27 @@ public:
     unsigned int size() const noexcept override;
 
 
+    // rank() returns the number of elements in the set that are less
+    // than the given one, which is the given element's position (counting
+    // from 0) if it's in the set.  Only available when Indexed is true;
+    // runs in an expected time of O(log n).
+    unsigned int rank(const ElementType& element) const;
+
+
+    // select() returns the element at the given position (counting from
+    // 0) in ascending order.  If there is no such position, it throws a
+    // std::out_of_range instead.  Only available when Indexed is true;
+    // runs in an expected time of O(log n).
+    const ElementType& select(unsigned int index) const;
+
+
+    // eraseAt() removes the element at the given position (counting from
+    // 0) in ascending order.  If there is no such position, it throws a
+    // std::out_of_range instead.  Only available when Indexed is true;
+    // runs in an expected time of O(log n).
+    void eraseAt(unsigned int index);
+
+
     // levelCount() returns the number of levels in the skip list.
     unsigned int levelCount() const noexcept;
 
@@ -262,108 +324,724 @@ public:
 
 
 private:
+    // Each element lives in a single allocation: a Node holding its key
+    // and the height of its tower, followed immediately in memory by an
+    // inline array of "height" links, one for each level the element
+    // occupies.  A search that compares against a node's key will find
+    // the link it needs next to it, rather than chasing a separate node
+    // for every level.
+    //
+    // -INF and +INF are represented by the head and tail towers, which
+    // have no key at all; they're recognized by their addresses, so the
+    // search loops never compare anything but ElementTypes.
+    struct Node
+    {
+        Node() noexcept {}
+        ~Node() noexcept {}
+
+        union
+        {
+            ElementType key;
+        };
+
+        unsigned int height;
+    };
+
+    // Positions count the head as 0, the elements as 1 through n, and the
+    // tail as n + 1; a link's width is the difference between the
+    // positions of the towers at either end of it.
+    struct PlainLink
+    {
+        Node* next;
+    };
+
+    struct IndexedLink
+    {
+        Node* next;
+        unsigned int width;
+    };
+
+    using Link = std::conditional_t<Indexed, IndexedLink, PlainLink>;
+
+    static Node* createSentinel(unsigned int height);
+    static Node* createNode(const ElementType& element, unsigned int height);
+    static void destroySentinel(Node* node) noexcept;
+    static void destroyNode(Node* node) noexcept;
+    static Link* links(const Node* node) noexcept;
+
+    SkipListLevelTester<ElementType>& tester();
+    void createSentinels();
+    void growHead(unsigned int height);
+    void raiseLevels(unsigned int height);
+    void destroyNodes() noexcept;
+    Node* findPredecessors(const ElementType& element);
+    void findPosition(unsigned int position);
+    const Node* find(const ElementType& element) const;
+    void appendNode(Node* node);
+    void finishAppending() noexcept;
+
+private:
+    // A set that's been moved from has no level tester, and is given a
+    // default one when it next needs one.
     std::unique_ptr<SkipListLevelTester<ElementType>> levelTester;
 
-    // You'll no doubt want to add member variables and "helper" member
-    // functions here.
+    // The -INF and +INF towers.  The head's tower is as tall as its
+    // capacity allows, which may be more than the number of levels
+    // currently in use; the unused links all point to the tail.  Both
+    // are allocated lazily by the first call to add().
+    Node* head;
+    Node* tail;
+
+    // The number of levels in the skip list.  The top level always
+    // contains only -INF and +INF, so an empty skip list has one level.
+    unsigned int levels;
+    unsigned int sz;
+
+    // Scratch space, kept around so that adding doesn't allocate it anew,
+    // remembering the last tower visited on each level by a search (or
+    // the last tower appended on each level by assignSorted()), along
+    // with its position if the skip list is indexed.
+    std::vector<Node*> predecessors;
+    std::vector<unsigned int> predecessorPositions;
 };
 
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet()
-    : SkipListSet{std::make_unique<RandomSkipListLevelTester<ElementType>>()}
+template <typename ElementType, bool Indexed>
+typename SkipListSet<ElementType, Indexed>::Node* SkipListSet<ElementType, Indexed>::createSentinel(
+    unsigned int height)
 {
+    void* memory = ::operator new(
+        (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link)
+        + height * sizeof(Link));
+
+    Node* node = new (memory) Node;
+    node->height = height;
+
+    return node;
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester)
-    : levelTester{std::move(levelTester)}
+template <typename ElementType, bool Indexed>
+typename SkipListSet<ElementType, Indexed>::Node* SkipListSet<ElementType, Indexed>::createNode(
+    const ElementType& element, unsigned int height)
 {
+    Node* node = createSentinel(height);
+
+    try
+    {
+        new (&node->key) ElementType{element};
+    }
+    catch (...)
+    {
+        destroySentinel(node);
+        throw;
+    }
+
+    return node;
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::~SkipListSet() noexcept
+template <typename ElementType, bool Indexed>
+void SkipListSet<ElementType, Indexed>::destroySentinel(Node* node) noexcept
 {
+    node->~Node();
+    ::operator delete(node);
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(const SkipListSet& s)
+template <typename ElementType, bool Indexed>
+void SkipListSet<ElementType, Indexed>::destroyNode(Node* node) noexcept
 {
+    node->key.~ElementType();
+    destroySentinel(node);
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(SkipListSet&& s) noexcept
+template <typename ElementType, bool Indexed>
+typename SkipListSet<ElementType, Indexed>::Link* SkipListSet<ElementType, Indexed>::links(
+    const Node* node) noexcept
 {
+    // The tower begins at the first suitably-aligned address past the Node.
+    return reinterpret_cast<Link*>(
+        const_cast<char*>(reinterpret_cast<const char*>(node))
+        + (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link));
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>& SkipListSet<ElementType>::operator=(const SkipListSet& s)
+template <typename ElementType, bool Indexed>
+SkipListLevelTester<ElementType>& SkipListSet<ElementType, Indexed>::tester()
+{
+    if (levelTester == nullptr)
+    {
+        levelTester = std::make_unique<GeometricSkipListLevelTester<ElementType>>();
+    }
+
+    return *levelTester;
+}
+
+
+template <typename ElementType, bool Indexed>
+void SkipListSet<ElementType, Indexed>::createSentinels()
 {
+    constexpr unsigned int INITIAL_HEAD_HEIGHT = 16;
+
+    tail = createSentinel(0);
+
+    try
+    {
+        head = createSentinel(INITIAL_HEAD_HEIGHT);
+    }
+    catch (...)
+    {
+        destroySentinel(tail);
+        tail = nullptr;
+        throw;
+    }
+
+    for (unsigned int level = 0; level < head->height; ++level)
+    {
+        links(head)[level].next = tail;
+
+        if constexpr (Indexed)
+        {
+            links(head)[level].width = 1;
+        }
+    }
+}
+
+
+template <typename ElementType, bool Indexed>
+void SkipListSet<ElementType, Indexed>::growHead(unsigned int height)
+{
+    if (height <= head->height)
+    {
+        return;
+    }
+
+    Node* newHead = createSentinel(std::max(height, head->height * 2));
+
+    std::copy(links(head), links(head) + head->height, links(newHead));
+
+    for (unsigned int level = head->height; level < newHead->height; ++level)
+    {
+        links(newHead)[level].next = tail;
+    }
+
+    std::replace(predecessors.begin(), predecessors.end(), head, newHead);
+
+    destroySentinel(head);
+    head = newHead;
+}
+
+
+// raiseLevels() makes sure there are enough levels for a tower of the
+// given height, remembering that the top level has to stay empty.  The
+// head is the predecessor, at position 0, on any new levels.
+
+template <typename ElementType, bool Indexed>
+void SkipListSet<ElementType, Indexed>::raiseLevels(unsigned int height)
+{
+    if (height < levels)
+    {
+        return;
+    }
+
+    growHead(height + 1);
+
+    for (unsigned int level = levels; level <= height; ++level)
+    {
+        links(head)[level].next = tail;
+
+        if constexpr (Indexed)
+        {
+            links(head)[level].width = sz + 1;
+        }
+    }
+
+    predecessors.resize(height + 1, head);
+    predecessorPositions.resize(height + 1, 0);
+    levels = height + 1;
+}
+
+
+template <typename ElementType, bool Indexed>
+void SkipListSet<ElementType, Indexed>::destroyNodes() noexcept
+{
+    if (head == nullptr)
+    {
+        return;
+    }
+
+    Node* current = links(head)[0].next;
+
+    while (current != tail)
+    {
+        Node* next = links(current)[0].next;
+        destroyNode(current);
+        current = next;
+    }
+
+    destroySentinel(head);
+    destroySentinel(tail);
+
+    head = nullptr;
+    tail = nullptr;
+    levels = 1;
+    sz = 0;
+}
+
+
+template <typename ElementType, bool Indexed>
+typename SkipListSet<ElementType, Indexed>::Node* SkipListSet<ElementType, Indexed>::findPredecessors(
+    const ElementType& element)
+{
+    predecessors.resize(levels);
+    predecessorPositions.resize(levels);
+
+    Node* current = head;
+    unsigned int position = 0;
+
+    for (unsigned int level = levels; level-- > 0; )
+    {
+        Node* next = links(current)[level].next;
+
+        while (next != tail && next->key < element)
+        {
+            if constexpr (Indexed)
+            {
+                position += links(current)[level].width;
+            }
+
+            current = next;
+            next = links(current)[level].next;
+        }
+
+        predecessors[level] = current;
+        predecessorPositions[level] = position;
+    }
+
+    return links(current)[0].next;
+}
+
+
+// findPosition() is findPredecessors() for an indexed skip list, except
+// that it searches for the tower at the given position instead of the
+// one with a given key.
+
+template <typename ElementType, bool Indexed>
+void SkipListSet<ElementType, Indexed>::findPosition(unsigned int target)
+{
+    predecessors.resize(levels);
+    predecessorPositions.resize(levels);
+
+    Node* current = head;
+    unsigned int position = 0;
+
+    for (unsigned int level = levels; level-- > 0; )
+    {
+        while (position + links(current)[level].width < target)
+        {
+            position += links(current)[level].width;
+            current = links(current)[level].next;
+        }
+
+        predecessors[level] = current;
+        predecessorPositions[level] = position;
+    }
+}
+
+
+template <typename ElementType, bool Indexed>
+const typename SkipListSet<ElementType, Indexed>::Node* SkipListSet<ElementType, Indexed>::find(
+    const ElementType& element) const
+{
+    if (head == nullptr)
+    {
+        return nullptr;
+    }
+
+    const Node* current = head;
+
+    for (unsigned int level = levels; level-- > 0; )
+    {
+        const Node* next = links(current)[level].next;
+
+        while (next != tail && next->key < element)
+        {
+            current = next;
+            next = links(current)[level].next;
+        }
+    }
+
+    const Node* candidate = links(current)[0].next;
+    return candidate != tail && candidate->key == element ? candidate : nullptr;
+}
+
+
+// appendNode() links a tower in after every other one, given that
+// predecessors holds the last tower on each level and that raiseLevels()
+// has already made room for it.  The links from the last towers to the
+// tail are left for finishAppending() to complete.
+
+template <typename ElementType, bool Indexed>
+void SkipListSet<ElementType, Indexed>::appendNode(Node* node)
+{
+    unsigned int position = sz + 1;
+
+    for (unsigned int level = 0; level < node->height; ++level)
+    {
+        links(predecessors[level])[level].next = node;
+        links(node)[level].next = tail;
+
+        if constexpr (Indexed)
+        {
+            links(predecessors[level])[level].width = position - predecessorPositions[level];
+        }
+
+        predecessors[level] = node;
+        predecessorPositions[level] = position;
+    }
+
+    ++sz;
+}
+
+
+template <typename ElementType, bool Indexed>
+void SkipListSet<ElementType, Indexed>::finishAppending() noexcept
+{
+    if constexpr (Indexed)
+    {
+        for (unsigned int level = 0; level < levels; ++level)
+        {
+            links(predecessors[level])[level].width = sz + 1 - predecessorPositions[level];
+        }
+    }
+}
+
+
+
+template <typename ElementType, bool Indexed>
+SkipListSet<ElementType, Indexed>::SkipListSet()
+    : SkipListSet{std::make_unique<GeometricSkipListLevelTester<ElementType>>()}
+{
+}
+
+
+template <typename ElementType, bool Indexed>
+SkipListSet<ElementType, Indexed>::SkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester)
+    : levelTester{std::move(levelTester)}, head{nullptr}, tail{nullptr}, levels{1}, sz{0}
+{
+}
+
+
+template <typename ElementType, bool Indexed>
+SkipListSet<ElementType, Indexed>::~SkipListSet() noexcept
+{
+    destroyNodes();
+}
+
+
+template <typename ElementType, bool Indexed>
+SkipListSet<ElementType, Indexed>::SkipListSet(const SkipListSet& s)
+    : levelTester{s.levelTester != nullptr ? s.levelTester->clone() : nullptr},
+      head{nullptr}, tail{nullptr}, levels{1}, sz{0}
+{
+    if (s.head == nullptr)
+    {
+        return;
+    }
+
+    createSentinels();
+    predecessors.assign(1, head);
+    predecessorPositions.assign(1, 0);
+
+    // Copying in order means every tower is appended after the last
+    // tower on each of its levels, so the copy takes linear time.
+    try
+    {
+        for (const Node* n = links(s.head)[0].next; n != s.tail; n = links(n)[0].next)
+        {
+            raiseLevels(n->height);
+            appendNode(createNode(n->key, n->height));
+        }
+    }
+    catch (...)
+    {
+        destroyNodes();
+        throw;
+    }
+
+    finishAppending();
+}
+
+
+template <typename ElementType, bool Indexed>
+SkipListSet<ElementType, Indexed>::SkipListSet(SkipListSet&& s) noexcept
+    : levelTester{std::move(s.levelTester)}, head{s.head}, tail{s.tail},
+      levels{s.levels}, sz{s.sz}
+{
+    s.head = nullptr;
+    s.tail = nullptr;
+    s.levels = 1;
+    s.sz = 0;
+}
+
+
+template <typename ElementType, bool Indexed>
+SkipListSet<ElementType, Indexed>& SkipListSet<ElementType, Indexed>::operator=(const SkipListSet& s)
+{
+    if (this != &s)
+    {
+        *this = SkipListSet{s};
+    }
+
     return *this;
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>& SkipListSet<ElementType>::operator=(SkipListSet&& s) noexcept
+template <typename ElementType, bool Indexed>
+SkipListSet<ElementType, Indexed>& SkipListSet<ElementType, Indexed>::operator=(SkipListSet&& s) noexcept
 {
+    std::swap(levelTester, s.levelTester);
+    std::swap(head, s.head);
+    std::swap(tail, s.tail);
+    std::swap(levels, s.levels);
+    std::swap(sz, s.sz);
+
     return *this;
 }
 
 
-template <typename ElementType>
-bool SkipListSet<ElementType>::isImplemented() const noexcept
+template <typename ElementType, bool Indexed>
+bool SkipListSet<ElementType, Indexed>::isImplemented() const noexcept
 {
-    return false;
+    return true;
 }
 
 
-template <typename ElementType>
-void SkipListSet<ElementType>::add(const ElementType& element)
+template <typename ElementType, bool Indexed>
+void SkipListSet<ElementType, Indexed>::add(const ElementType& element)
 {
+    if (head == nullptr)
+    {
+        createSentinels();
+    }
+
+    Node* next = findPredecessors(element);
+
+    if (next != tail && next->key == element)
+    {
+        return;
+    }
+
+    unsigned int height = tester().levelFor(element) + 1;
+    raiseLevels(height);
+
+    Node* node = createNode(element, height);
+    unsigned int position = predecessorPositions[0] + 1;
+
+    for (unsigned int level = 0; level < height; ++level)
+    {
+        Link& link = links(predecessors[level])[level];
+
+        links(node)[level].next = link.next;
+        link.next = node;
+
+        if constexpr (Indexed)
+        {
+            links(node)[level].width = link.width - (position - predecessorPositions[level]) + 1;
+            link.width = position - predecessorPositions[level];
+        }
+    }
+
+    if constexpr (Indexed)
+    {
+        for (unsigned int level = height; level < levels; ++level)
+        {
+            ++links(predecessors[level])[level].width;
+        }
+    }
+
+    ++sz;
 }
 
 
-template <typename ElementType>
-bool SkipListSet<ElementType>::contains(const ElementType& element) const
+template <typename ElementType, bool Indexed>
+template <typename InputIterator>
+void SkipListSet<ElementType, Indexed>::assignSorted(InputIterator first, InputIterator last)
 {
-    return false;
+    destroyNodes();
+    createSentinels();
+    predecessors.assign(1, head);
+    predecessorPositions.assign(1, 0);
+
+    try
+    {
+        for (; first != last; ++first)
+        {
+            if (sz > 0 && !(predecessors[0]->key < *first))
+            {
+                continue;
+            }
+
+            unsigned int height = tester().levelFor(*first) + 1;
+            raiseLevels(height);
+            appendNode(createNode(*first, height));
+        }
+    }
+    catch (...)
+    {
+        finishAppending();
+        throw;
+    }
+
+    finishAppending();
 }
 
 
-template <typename ElementType>
-unsigned int SkipListSet<ElementType>::size() const noexcept
+template <typename ElementType, bool Indexed>
+bool SkipListSet<ElementType, Indexed>::contains(const ElementType& element) const
 {
-    return 0;
+    return find(element) != nullptr;
 }
 
 
-template <typename ElementType>
-unsigned int SkipListSet<ElementType>::levelCount() const noexcept
+template <typename ElementType, bool Indexed>
+unsigned int SkipListSet<ElementType, Indexed>::size() const noexcept
 {
-    return 0;
+    return sz;
 }
 
 
-template <typename ElementType>
-unsigned int SkipListSet<ElementType>::elementsOnLevel(unsigned int level) const noexcept
+template <typename ElementType, bool Indexed>
+unsigned int SkipListSet<ElementType, Indexed>::rank(const ElementType& element) const
+{
+    static_assert(Indexed, "rank() requires an indexed SkipListSet");
+
+    if (head == nullptr)
+    {
+        return 0;
+    }
+
+    const Node* current = head;
+    unsigned int position = 0;
+
+    for (unsigned int level = levels; level-- > 0; )
+    {
+        const Node* next = links(current)[level].next;
+
+        while (next != tail && next->key < element)
+        {
+            position += links(current)[level].width;
+            current = next;
+            next = links(current)[level].next;
+        }
+    }
+
+    return position;
+}
+
+
+template <typename ElementType, bool Indexed>
+const ElementType& SkipListSet<ElementType, Indexed>::select(unsigned int index) const
 {
-    return 0;
+    static_assert(Indexed, "select() requires an indexed SkipListSet");
+
+    if (index >= sz)
+    {
+        throw std::out_of_range{"SkipListSet::select: index out of range"};
+    }
+
+    const Node* current = head;
+    unsigned int position = 0;
+
+    for (unsigned int level = levels; level-- > 0 && position != index + 1; )
+    {
+        while (position + links(current)[level].width <= index + 1)
+        {
+            position += links(current)[level].width;
+            current = links(current)[level].next;
+        }
+    }
+
+    return current->key;
 }
 
 
-template <typename ElementType>
-bool SkipListSet<ElementType>::isElementOnLevel(const ElementType& element, unsigned int level) const
+template <typename ElementType, bool Indexed>
+void SkipListSet<ElementType, Indexed>::eraseAt(unsigned int index)
 {
-    return false;
+    static_assert(Indexed, "eraseAt() requires an indexed SkipListSet");
+
+    if (index >= sz)
+    {
+        throw std::out_of_range{"SkipListSet::eraseAt: index out of range"};
+    }
+
+    findPosition(index + 1);
+
+    Node* node = links(predecessors[0])[0].next;
+
+    for (unsigned int level = 0; level < levels; ++level)
+    {
+        Link& link = links(predecessors[level])[level];
+
+        if (level < node->height)
+        {
+            link.width += links(node)[level].width - 1;
+            link.next = links(node)[level].next;
+        }
+        else
+        {
+            --link.width;
+        }
+    }
+
+    destroyNode(node);
+    --sz;
+
+    // Keep exactly one empty level on top.
+    while (levels > 1 && links(head)[levels - 2].next == tail)
+    {
+        --levels;
+    }
 }
 
 
+template <typename ElementType, bool Indexed>
+unsigned int SkipListSet<ElementType, Indexed>::levelCount() const noexcept
+{
+    return levels;
+}
 
-#endif
 
+template <typename ElementType, bool Indexed>
+unsigned int SkipListSet<ElementType, Indexed>::elementsOnLevel(unsigned int level) const noexcept
+{
+    if (head == nullptr || level >= levels)
+    {
+        return 0;
+    }
+
+    unsigned int count = 0;
+
+    for (const Node* n = links(head)[level].next; n != tail; n = links(n)[level].next)
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+
+template <typename ElementType, bool Indexed>
+bool SkipListSet<ElementType, Indexed>::isElementOnLevel(const ElementType& element, unsigned int level) const
+{
+    const Node* node = find(element);
+    return node != nullptr && level < node->height;
+}
+
+
+
+#endif
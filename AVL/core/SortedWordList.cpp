@@ -0,0 +1,94 @@
+// SortedWordList.cpp
+
+#include <algorithm>
+#include "LevenshteinAutomaton.hpp"
+#include "SortedWordList.hpp"
+
+
+SortedWordList::SortedWordList(std::vector<std::string> words, unsigned int maxDistance)
+    : maxDistance{maxDistance}, words{std::move(words)}
+{
+    std::sort(this->words.begin(), this->words.end());
+    this->words.erase(std::unique(this->words.begin(), this->words.end()), this->words.end());
+}
+
+
+std::vector<std::pair<std::string, unsigned int>> SortedWordList::findWithin(
+    std::string_view word, unsigned int distance) const
+{
+    LevenshteinAutomaton automaton{word, distance};
+    std::vector<std::pair<std::string, unsigned int>> found;
+
+    unsigned int i = 0;
+
+    while (i < words.size())
+    {
+        std::optional<std::string> match = automaton.nextMatch(words[i]);
+
+        if (!match)
+        {
+            break;
+        }
+
+        if (*match == words[i])
+        {
+            LevenshteinAutomaton::State state = automaton.start();
+
+            for (char c : words[i])
+            {
+                state = automaton.next(state, c);
+            }
+
+            found.emplace_back(words[i], automaton.distance(state));
+            ++i;
+        }
+        else
+        {
+            i = lowerBound(*match);
+        }
+    }
+
+    // The matches were found in alphabetical order, so a stable sort by
+    // distance leaves them that way among equals.
+    std::stable_sort(
+        found.begin(), found.end(),
+        [](const auto& a, const auto& b)
+        {
+            return a.second < b.second;
+        });
+
+    return found;
+}
+
+
+std::vector<std::string> SortedWordList::findSuggestions(const std::string& word) const
+{
+    std::vector<std::string> suggestions;
+
+    for (auto& [suggestion, distance] : findWithin(word, maxDistance))
+    {
+        suggestions.push_back(std::move(suggestion));
+    }
+
+    impl_::addSplits(word, [this](std::string_view s) { return contains(s); }, suggestions);
+
+    return suggestions;
+}
+
+
+bool SortedWordList::contains(std::string_view word) const
+{
+    return std::binary_search(words.begin(), words.end(), word);
+}
+
+
+unsigned int SortedWordList::size() const noexcept
+{
+    return words.size();
+}
+
+
+unsigned int SortedWordList::lowerBound(std::string_view s) const
+{
+    return std::lower_bound(words.begin(), words.end(), s) - words.begin();
+}
@@ -0,0 +1,70 @@
+// SortedWordList.hpp
+//
+// A SortedWordList is a SuggestionEngine that keeps the dictionary frozen
+// in one sorted array, and finds the words within a given edit distance
+// of a misspelled one by intersecting the array with a
+// LevenshteinAutomaton for it.
+//
+// Starting from the first word, it asks the automaton for the smallest
+// string it accepts that isn't less than the current word.  If that's
+// the word itself, it's a match, and the search moves on to the next
+// word; otherwise, it binary searches for the first word that isn't less
+// than that string, skipping every word in between without looking at
+// them.  Each step either finds a match or jumps past a range of words
+// that can't match, so the work done depends on the number of matches
+// (and the shape of the dictionary around them), not on its size.
+
+#ifndef SORTEDWORDLIST_HPP
+#define SORTEDWORDLIST_HPP
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "SuggestionEngine.hpp"
+
+
+
+class SortedWordList : public SuggestionEngine
+{
+public:
+    // Builds a SortedWordList containing the given words, which can be in
+    // any order and can contain duplicates.  findSuggestions() returns the
+    // words within the given edit distance; findWithin() can use any.
+    explicit SortedWordList(std::vector<std::string> words, unsigned int maxDistance = 1);
+
+
+    // findWithin() returns the words within the given edit distance of
+    // the given word, along with their distances, nearest first and
+    // alphabetically among words at the same distance.
+    std::vector<std::pair<std::string, unsigned int>> findWithin(
+        std::string_view word, unsigned int distance) const;
+
+
+    // findSuggestions() returns the words within the maximum edit distance
+    // of the given word, nearest first, followed by the word's splits into
+    // two words (see addSplits() in SuggestionEngine.hpp).
+    std::vector<std::string> findSuggestions(const std::string& word) const override;
+
+
+    // contains() returns true if the given word is in the dictionary.
+    bool contains(std::string_view word) const;
+
+
+    // size() returns the number of distinct words in the dictionary.
+    unsigned int size() const noexcept;
+
+
+    // lowerBound() returns the position of the first word that isn't less
+    // than the given string, or size() if there isn't one.
+    unsigned int lowerBound(std::string_view s) const;
+
+
+private:
+    unsigned int maxDistance;
+    std::vector<std::string> words;
+};
+
+
+
+#endif
@@ -0,0 +1,189 @@
+// SuggestionCache.cpp
+
+#include <functional>
+#include "SuggestionCache.hpp"
+
+
+double SuggestionCacheStats::hitRate() const noexcept
+{
+    std::size_t lookups = hits + misses;
+    return lookups > 0 ? static_cast<double>(hits) / lookups : 0.0;
+}
+
+
+
+SuggestionCache::SuggestionCache(
+    const WordChecker& checker, std::size_t capacity, unsigned int shardCount)
+    : checker{checker},
+      generation{0},
+      capacityPerShard{0},
+      shards{nullptr},
+      shardCount{shardCount > 0 ? shardCount : 1}
+{
+    capacityPerShard = (capacity + this->shardCount - 1) / this->shardCount;
+    shards = std::make_unique<Shard[]>(this->shardCount);
+
+    for (unsigned int i = 0; i < this->shardCount; ++i)
+    {
+        shards[i].dictionarySize = checker.dictionary().size();
+    }
+}
+
+
+std::vector<std::string> SuggestionCache::findSuggestions(const std::string& word) const
+{
+    Shard& shard = shards[std::hash<std::string>{}(word) % shardCount];
+    unsigned long long askedIn;
+    unsigned int dictionarySize;
+
+    {
+        // The generation is read while the shard is locked, so that each
+        // thread to lock it sees a generation at least as new as the one
+        // before it did, and the shard's never goes backward.
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        askedIn = generation.load();
+        dictionarySize = checker.dictionary().size();
+        invalidateIfChanged(shard, askedIn, dictionarySize);
+
+        auto found = shard.positions.find(word);
+
+        if (found != shard.positions.end())
+        {
+            ++shard.stats.hits;
+            shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+            return found->second->suggestions;
+        }
+
+        ++shard.stats.misses;
+    }
+
+    std::vector<std::string> suggestions = checker.findSuggestions(word);
+
+    if (capacityPerShard == 0)
+    {
+        return suggestions;
+    }
+
+    // If the dictionary changed while the suggestions were being found,
+    // they might already be out of date, so they aren't cached; if another
+    // thread cached this word in the meantime, there's nothing to do.
+    std::lock_guard<std::mutex> lock{shard.mutex};
+
+    if (generation.load() != askedIn || checker.dictionary().size() != dictionarySize)
+    {
+        return suggestions;
+    }
+
+    invalidateIfChanged(shard, askedIn, dictionarySize);
+
+    if (shard.positions.count(word) > 0)
+    {
+        return suggestions;
+    }
+
+    if (shard.entries.size() >= capacityPerShard)
+    {
+        Entry& oldest = shard.entries.back();
+
+        shard.stats.bytes -= oldest.bytes;
+        ++shard.stats.evictions;
+
+        shard.positions.erase(oldest.word);
+        shard.entries.pop_back();
+    }
+
+    shard.entries.push_front(Entry{word, suggestions, 0});
+    shard.entries.front().bytes = estimateBytes(shard.entries.front());
+    shard.stats.bytes += shard.entries.front().bytes;
+
+    shard.positions.emplace(word, shard.entries.begin());
+
+    return suggestions;
+}
+
+
+void SuggestionCache::invalidate() noexcept
+{
+    // The shards are emptied lazily, by invalidateIfChanged(), so that
+    // this needn't wait for every shard's lock.
+    ++generation;
+}
+
+
+void SuggestionCache::clear()
+{
+    for (unsigned int i = 0; i < shardCount; ++i)
+    {
+        std::lock_guard<std::mutex> lock{shards[i].mutex};
+
+        shards[i].entries.clear();
+        shards[i].positions.clear();
+        shards[i].stats.bytes = 0;
+    }
+}
+
+
+SuggestionCacheStats SuggestionCache::stats() const
+{
+    SuggestionCacheStats total;
+
+    for (unsigned int i = 0; i < shardCount; ++i)
+    {
+        std::lock_guard<std::mutex> lock{shards[i].mutex};
+
+        total.hits += shards[i].stats.hits;
+        total.misses += shards[i].stats.misses;
+        total.evictions += shards[i].stats.evictions;
+        total.invalidations += shards[i].stats.invalidations;
+        total.entries += shards[i].entries.size();
+        total.bytes += shards[i].stats.bytes;
+    }
+
+    return total;
+}
+
+
+std::size_t SuggestionCache::estimateBytes(const Entry& entry) noexcept
+{
+    // Each entry is a list node, a map node holding another copy of the
+    // word, and a bucket pointer, plus whatever the strings allocate.
+    auto allocated =
+        [](const std::string& s) -> std::size_t
+        {
+            return s.capacity() > std::string{}.capacity() ? s.capacity() + 1 : 0;
+        };
+
+    std::size_t bytes = sizeof(Entry) + 2 * sizeof(void*)
+        + sizeof(std::string) + sizeof(std::list<Entry>::iterator) + 2 * sizeof(void*)
+        + sizeof(void*)
+        + 2 * allocated(entry.word)
+        + entry.suggestions.capacity() * sizeof(std::string);
+
+    for (const std::string& suggestion : entry.suggestions)
+    {
+        bytes += allocated(suggestion);
+    }
+
+    return bytes;
+}
+
+
+void SuggestionCache::invalidateIfChanged(
+    Shard& shard, unsigned long long generation, unsigned int dictionarySize)
+{
+    if (shard.generation == generation && shard.dictionarySize == dictionarySize)
+    {
+        return;
+    }
+
+    if (!shard.entries.empty())
+    {
+        ++shard.stats.invalidations;
+    }
+
+    shard.entries.clear();
+    shard.positions.clear();
+    shard.stats.bytes = 0;
+    shard.generation = generation;
+    shard.dictionarySize = dictionarySize;
+}
@@ -0,0 +1,140 @@
+// SuggestionCache.hpp
+//
+// A SuggestionCache is a SuggestionEngine that remembers the suggestions
+// that a WordChecker found for recently-asked-about words, so that asking
+// again (as happens constantly in real text, where a few misspellings
+// account for most of them) doesn't mean finding them all over again.
+//
+// It holds at most a fixed number of words' suggestions, discarding the
+// least recently used ones to make room for new ones.  To let many threads
+// use it at once, it's split into shards, each with its own lock and its
+// own share of the capacity, and each word belongs to the shard chosen by
+// its hash.  A thread finding suggestions for a word that isn't cached
+// doesn't hold its shard's lock while doing so.
+//
+// Whatever changes the dictionary must then call invalidate(), after
+// which every shard throws out what it had cached the next time it's
+// used.  Since a Set can have words both added and removed, leaving its
+// size the same, the size alone can't say whether it changed; the cache
+// also notices the size changing, but only as a safety net.
+//
+// Because a WordChecker can be told to use any SuggestionEngine, the way
+// to cache a WordChecker's suggestions is to build a SuggestionCache
+// around it, then use another WordChecker (on the same Set) that's told
+// to use the cache.
+
+#ifndef SUGGESTIONCACHE_HPP
+#define SUGGESTIONCACHE_HPP
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SuggestionEngine.hpp"
+#include "WordChecker.hpp"
+
+
+
+struct SuggestionCacheStats
+{
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+
+    // The number of times a shard was emptied because the dictionary
+    // changed.
+    std::size_t invalidations = 0;
+
+    std::size_t entries = 0;
+
+    // An estimate of the memory used by the cached words and suggestions,
+    // including the cache's own bookkeeping.
+    std::size_t bytes = 0;
+
+    double hitRate() const noexcept;
+};
+
+
+
+class SuggestionCache : public SuggestionEngine
+{
+public:
+    static constexpr unsigned int DEFAULT_SHARD_COUNT = 16;
+
+    // Builds a SuggestionCache that caches the suggestions of the given
+    // WordChecker for at most the given number of words (rounded up to a
+    // multiple of the number of shards).  The WordChecker must outlive
+    // the cache.
+    SuggestionCache(
+        const WordChecker& checker, std::size_t capacity,
+        unsigned int shardCount = DEFAULT_SHARD_COUNT);
+
+
+    // findSuggestions() returns the WordChecker's suggestions for the
+    // given word, from the cache if they're there.
+    std::vector<std::string> findSuggestions(const std::string& word) const override;
+
+
+    // invalidate() tells the cache that the dictionary has changed, so
+    // that nothing cached before then is returned afterward, including
+    // suggestions being found at the time.  It's safe to call while other
+    // threads are finding suggestions.
+    void invalidate() noexcept;
+
+
+    // clear() empties the cache, without resetting the counters.
+    void clear();
+
+
+    // stats() returns the counters, totaled across the shards.
+    SuggestionCacheStats stats() const;
+
+
+private:
+    struct Entry
+    {
+        std::string word;
+        std::vector<std::string> suggestions;
+        std::size_t bytes;
+    };
+
+    // Each shard keeps its entries in a list, most recently used first,
+    // with a map from words to their positions in the list.
+    struct Shard
+    {
+        std::mutex mutex;
+        std::list<Entry> entries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> positions;
+
+        // The generation and the dictionary's size when the entries were
+        // found.
+        unsigned long long generation = 0;
+        unsigned int dictionarySize = 0;
+
+        SuggestionCacheStats stats;
+    };
+
+    static std::size_t estimateBytes(const Entry& entry) noexcept;
+
+    // Empties the shard if the generation or the dictionary's size has
+    // changed since its entries were found.  The shard must be locked.
+    static void invalidateIfChanged(
+        Shard& shard, unsigned long long generation, unsigned int dictionarySize);
+
+private:
+    const WordChecker& checker;
+
+    // The number of times invalidate() has been called.
+    std::atomic<unsigned long long> generation;
+
+    std::size_t capacityPerShard;
+    std::unique_ptr<Shard[]> shards;
+    unsigned int shardCount;
+};
+
+
+
+#endif
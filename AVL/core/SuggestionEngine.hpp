@@ -0,0 +1,138 @@
+// SuggestionEngine.hpp
+//
+// A SuggestionEngine is anything that can suggest alternative spellings
+// for a word, using some data structure built ahead of time from the
+// dictionary.  A WordChecker can be told to use one in place of its own
+// generate-every-edit-and-look-it-up approach.
+
+#ifndef SUGGESTIONENGINE_HPP
+#define SUGGESTIONENGINE_HPP
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class SuggestionEngine
+{
+public:
+    virtual ~SuggestionEngine() = default;
+
+    // findSuggestions() returns a vector containing suggested alternative
+    // spellings for the given word, with no duplicates.
+    virtual std::vector<std::string> findSuggestions(const std::string& word) const = 0;
+};
+
+
+
+namespace impl_
+{
+    // addSplits() appends to the given suggestions every way of splitting
+    // the given word into two words, separated by a space, in order of
+    // where it's split; contains(s) says whether the string_view s is a
+    // word.
+    template <typename Contains>
+    void addSplits(const std::string& word, Contains contains, std::vector<std::string>& suggestions);
+
+
+    // A SuggestionIndex keeps track of which strings are in a vector of
+    // suggestions, so that checking a new one for a duplicate takes
+    // constant time rather than a search of the whole vector.  It's a
+    // small open-addressing hash table (with linear probing) of positions
+    // in the vector, allocated only once there's something to put in it.
+    class SuggestionIndex
+    {
+    public:
+        explicit SuggestionIndex(std::vector<std::string>& suggestions);
+
+        // addIfNew() appends a copy of the given string to the suggestions,
+        // unless it's already there.
+        void addIfNew(std::string_view suggestion);
+
+    private:
+        static constexpr std::size_t INITIAL_SLOTS = 64;
+        static constexpr unsigned int EMPTY = 0;
+
+        void grow();
+
+        std::vector<std::string>& suggestions;
+
+        // Each slot holds one more than a position in suggestions, or
+        // EMPTY.  The number of slots is always a power of two, at least
+        // twice the number of suggestions.
+        std::vector<unsigned int> slots;
+    };
+
+
+
+    template <typename Contains>
+    void addSplits(const std::string& word, Contains contains, std::vector<std::string>& suggestions)
+    {
+        std::string_view w{word};
+
+        for (std::size_t i = 1; i < w.size(); ++i)
+        {
+            if (contains(w.substr(0, i)) && contains(w.substr(i)))
+            {
+                suggestions.push_back(word.substr(0, i) + " " + word.substr(i));
+            }
+        }
+    }
+
+
+    inline SuggestionIndex::SuggestionIndex(std::vector<std::string>& suggestions)
+        : suggestions{suggestions}
+    {
+    }
+
+
+    inline void SuggestionIndex::addIfNew(std::string_view suggestion)
+    {
+        if ((suggestions.size() + 1) * 2 > slots.size())
+        {
+            grow();
+        }
+
+        std::size_t mask = slots.size() - 1;
+        std::size_t slot = std::hash<std::string_view>{}(suggestion) & mask;
+
+        while (slots[slot] != EMPTY)
+        {
+            if (suggestions[slots[slot] - 1] == suggestion)
+            {
+                return;
+            }
+
+            slot = (slot + 1) & mask;
+        }
+
+        suggestions.emplace_back(suggestion);
+        slots[slot] = suggestions.size();
+    }
+
+
+    inline void SuggestionIndex::grow()
+    {
+        slots.assign(slots.empty() ? INITIAL_SLOTS : slots.size() * 2, EMPTY);
+
+        std::size_t mask = slots.size() - 1;
+
+        for (std::size_t i = 0; i < suggestions.size(); ++i)
+        {
+            std::size_t slot = std::hash<std::string_view>{}(suggestions[i]) & mask;
+
+            while (slots[slot] != EMPTY)
+            {
+                slot = (slot + 1) & mask;
+            }
+
+            slots[slot] = i + 1;
+        }
+    }
+}
+
+
+
+#endif
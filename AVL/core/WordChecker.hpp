@@ -5,18 +5,29 @@
 #define WORDCHECKER_HPP
 
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "Set.hpp"
+#include "SuggestionEngine.hpp"
 
 
 
-class WordChecker
+// BasicWordChecker is a class template whose type parameter is the kind
+// of Set it looks words up in.  When that's a concrete class, such as
+// HashSet<std::string> or AVLSet<std::string>, every lookup is a direct
+// call that the compiler can inline into the loops that generate
+// suggestions; when it's Set<std::string> itself, every lookup is a
+// virtual call, but any kind of Set can be used.  WordChecker, below, is
+// the latter.
+
+template <typename SetType>
+class BasicWordChecker
 {
 public:
     // The constructor requires a Set of words to be passed into it.  The
     // WordChecker will store a reference to a const Set, which it will use
     // whenever it needs to look up a word.
-    WordChecker(const Set<std::string>& words);
+    BasicWordChecker(const SetType& words);
 
 
     // wordExists() returns true if the given word is spelled correctly,
@@ -31,12 +42,191 @@ public:
     std::vector<std::string> findSuggestions(const std::string& word) const;
 
 
+    // setSuggestionEngine() makes findSuggestions() ask the given
+    // SuggestionEngine for suggestions, instead of generating every edit
+    // of the word and looking each one up in the Set.  The engine is not
+    // owned by the WordChecker and must outlive it (or be replaced first);
+    // passing nullptr goes back to generating edits.
+    void setSuggestionEngine(const SuggestionEngine* engine) noexcept;
+
+
+    // dictionary() returns the Set that words are looked up in.
+    const SetType& dictionary() const noexcept;
+
+
 private:
-    const Set<std::string>& words;
+    const SetType& words;
+    const SuggestionEngine* engine;
 
 };
 
 
 
-#endif
+template <typename SetType>
+BasicWordChecker<SetType>::BasicWordChecker(const SetType& words)
+    : words{words}, engine{nullptr}
+{
+}
 
+
+template <typename SetType>
+bool BasicWordChecker<SetType>::wordExists(const std::string& word) const
+{
+    // Naming the class whose contains() should be called turns off virtual
+    // dispatch, but Set<std::string> has no contains() to call directly.
+    if constexpr (std::is_abstract_v<SetType>)
+    {
+        return words.contains(word);
+    }
+    else
+    {
+        return words.SetType::contains(word);
+    }
+}
+
+
+template <typename SetType>
+std::vector<std::string> BasicWordChecker<SetType>::findSuggestions(const std::string& word) const
+{
+    if (engine != nullptr)
+    {
+        return engine->findSuggestions(word);
+    }
+
+    static const std::string letters = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    std::vector<std::string> suggestions;
+    impl_::SuggestionIndex index{suggestions};
+
+    auto suggest =
+        [&](const std::string& candidate)
+        {
+            if (wordExists(candidate))
+            {
+                index.addIfNew(candidate);
+            }
+        };
+
+    // Every candidate is made by editing one scratch string in place, which
+    // has room for the longest candidate, so the Set is always handed the
+    // same std::string and probing it never allocates.  Only candidates
+    // that turn out to be words are copied.
+    std::string candidate;
+    candidate.reserve(word.size() + 1);
+
+    //Swap adjacent pair
+    candidate = word;
+
+    for (std::size_t i = 0; i + 1 < word.size(); i++)
+    {
+        std::swap(candidate[i], candidate[i + 1]);
+        suggest(candidate);
+        std::swap(candidate[i], candidate[i + 1]);
+    }
+
+    //insert in between each adj pair
+    //
+    // The candidate is the word with an empty slot at position i; moving
+    // the slot one position to the right means filling its old position
+    // with the letter that was after it.
+    candidate.assign(1, ' ');
+    candidate += word;
+
+    for (std::size_t i = 0; i <= word.size(); i++)
+    {
+        for (char letter : letters)
+        {
+            candidate[i] = letter;
+            suggest(candidate);
+        }
+
+        if (i < word.size())
+        {
+            candidate[i] = word[i];
+        }
+    }
+
+    //delete each char
+    //
+    // Similarly, the candidate is the word without the character at
+    // position i, and moving on to the next one means putting that
+    // character back where the next one was.
+    if (!word.empty())
+    {
+        candidate.assign(word, 1, std::string::npos);
+
+        for (std::size_t i = 0; i < word.size(); i++)
+        {
+            suggest(candidate);
+
+            if (i + 1 < word.size())
+            {
+                candidate[i] = word[i];
+            }
+        }
+    }
+
+    //replace each char
+    candidate = word;
+
+    for (std::size_t i = 0; i < word.size(); i++)
+    {
+        for (char letter : letters)
+        {
+            candidate[i] = letter;
+            suggest(candidate);
+        }
+
+        candidate[i] = word[i];
+    }
+
+    //split up
+    std::string firstPart;
+    std::string secondPart;
+    firstPart.reserve(word.size());
+    secondPart.reserve(word.size());
+
+    for (std::size_t i = 1; i < word.size(); i++)
+    {
+        firstPart.assign(word, 0, i);
+        secondPart.assign(word, i, std::string::npos);
+
+        if (wordExists(firstPart) && wordExists(secondPart))
+        {
+            index.addIfNew(firstPart + " " + secondPart);
+        }
+    }
+
+
+    return suggestions;
+}
+
+
+template <typename SetType>
+void BasicWordChecker<SetType>::setSuggestionEngine(const SuggestionEngine* engine) noexcept
+{
+    this->engine = engine;
+}
+
+
+template <typename SetType>
+const SetType& BasicWordChecker<SetType>::dictionary() const noexcept
+{
+    return words;
+}
+
+
+
+extern template class BasicWordChecker<Set<std::string>>;
+
+
+
+class WordChecker : public BasicWordChecker<Set<std::string>>
+{
+public:
+    using BasicWordChecker<Set<std::string>>::BasicWordChecker;
+};
+
+
+
+#endif
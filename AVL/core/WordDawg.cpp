@@ -0,0 +1,224 @@
+// WordDawg.cpp
+
+#include <algorithm>
+#include <unordered_map>
+#include "WordDawg.hpp"
+
+
+namespace
+{
+    // While building, the words are first stored in an ordinary trie.
+    struct TrieNode
+    {
+        bool isWord = false;
+        std::vector<std::pair<char, unsigned int>> children;
+    };
+}
+
+
+WordDawg::WordDawg(std::vector<std::string> words)
+    : root{NONE}, wordCount{0}
+{
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    wordCount = words.size();
+
+    // Since the words are sorted, each new child is always added after a
+    // node's existing ones, so every node's children end up sorted too.
+    std::vector<TrieNode> trie(1);
+
+    for (const std::string& word : words)
+    {
+        unsigned int node = 0;
+
+        for (char c : word)
+        {
+            std::vector<std::pair<char, unsigned int>>& children = trie[node].children;
+
+            if (children.empty() || children.back().first != c)
+            {
+                children.emplace_back(c, trie.size());
+                trie.emplace_back();
+            }
+
+            node = trie[node].children.back().second;
+        }
+
+        trie[node].isWord = true;
+    }
+
+    // Working from the leaves up, replace each trie node with an
+    // equivalent node already in the graph (one that is a word or not in
+    // the same way, and has the same labeled edges to the same nodes), or
+    // add it to the graph if there isn't one.  Children are always added
+    // before their parents, so the trie's nodes are visited in reverse.
+    std::vector<unsigned int> replacement(trie.size());
+    std::unordered_map<std::string, unsigned int> registry;
+    std::string signature;
+
+    for (unsigned int t = trie.size(); t-- > 0; )
+    {
+        signature.assign(1, trie[t].isWord ? '1' : '0');
+
+        for (const auto& [label, target] : trie[t].children)
+        {
+            unsigned int node = replacement[target];
+
+            signature += label;
+            signature.append(reinterpret_cast<const char*>(&node), sizeof(node));
+        }
+
+        auto [existing, added] = registry.emplace(signature, nodes.size());
+
+        if (added)
+        {
+            nodes.push_back(Node{
+                static_cast<unsigned int>(edgeLabels.size()),
+                static_cast<unsigned int>(trie[t].children.size()),
+                trie[t].isWord});
+
+            for (const auto& [label, target] : trie[t].children)
+            {
+                edgeLabels.push_back(label);
+                edgeTargets.push_back(replacement[target]);
+            }
+        }
+
+        replacement[t] = existing->second;
+    }
+
+    root = replacement[0];
+}
+
+
+bool WordDawg::contains(std::string_view word) const
+{
+    unsigned int node = follow(root, word);
+    return node != NONE && nodes[node].isWord;
+}
+
+
+unsigned int WordDawg::size() const noexcept
+{
+    return wordCount;
+}
+
+
+unsigned int WordDawg::nodeCount() const noexcept
+{
+    return nodes.size();
+}
+
+
+std::vector<std::string> WordDawg::findSuggestions(const std::string& word) const
+{
+    std::vector<std::string> suggestions;
+    impl_::SuggestionIndex index{suggestions};
+
+    std::string_view w{word};
+    std::string suggestion;
+
+    // Adds the suggestion made of the word's first "keep" characters, then
+    // the given middle, then whatever's left of the word from "resume" on.
+    auto suggest =
+        [&](std::size_t keep, std::string_view middle, std::size_t resume)
+        {
+            suggestion.assign(w.substr(0, keep));
+            suggestion.append(middle);
+            suggestion.append(w.substr(resume));
+            index.addIfNew(suggestion);
+        };
+
+    auto isWordAt =
+        [this](unsigned int node)
+        {
+            return node != NONE && nodes[node].isWord;
+        };
+
+    unsigned int node = root;
+
+    // node is where the first i characters of the word lead.
+    for (std::size_t i = 0; node != NONE; ++i)
+    {
+        const Node& n = nodes[node];
+
+        for (unsigned int e = n.firstEdge; e < n.firstEdge + n.edgeCount; ++e)
+        {
+            char letter = edgeLabels[e];
+
+            if (letter < 'A' || letter > 'Z')
+            {
+                continue;
+            }
+
+            // Insert the letter before position i.
+            if (isWordAt(follow(edgeTargets[e], w.substr(i))))
+            {
+                suggest(i, std::string_view{&letter, 1}, i);
+            }
+
+            // Replace the character at position i with the letter.
+            if (i < w.size() && isWordAt(follow(edgeTargets[e], w.substr(i + 1))))
+            {
+                suggest(i, std::string_view{&letter, 1}, i + 1);
+            }
+        }
+
+        if (i == w.size())
+        {
+            break;
+        }
+
+        // Delete the character at position i.
+        if (isWordAt(follow(node, w.substr(i + 1))))
+        {
+            suggest(i, "", i + 1);
+        }
+
+        // Swap the characters at positions i and i + 1.
+        if (i + 1 < w.size())
+        {
+            char swapped[2] = {w[i + 1], w[i]};
+
+            unsigned int afterSwap = follow(node, std::string_view{swapped, 2});
+
+            if (isWordAt(follow(afterSwap, w.substr(i + 2))))
+            {
+                suggest(i, std::string_view{swapped, 2}, i + 2);
+            }
+        }
+
+        node = child(node, w[i]);
+    }
+
+    impl_::addSplits(word, [this](std::string_view s) { return contains(s); }, suggestions);
+
+    return suggestions;
+}
+
+
+unsigned int WordDawg::child(unsigned int node, char label) const noexcept
+{
+    const Node& n = nodes[node];
+
+    auto first = edgeLabels.begin() + n.firstEdge;
+    auto last = first + n.edgeCount;
+    auto found = std::lower_bound(first, last, label);
+
+    return found != last && *found == label ? edgeTargets[found - edgeLabels.begin()] : NONE;
+}
+
+
+// follow() returns the node that the given characters lead to, starting
+// from the given node, or NONE if they lead out of the graph.
+
+unsigned int WordDawg::follow(unsigned int node, std::string_view rest) const noexcept
+{
+    for (std::size_t i = 0; i < rest.size() && node != NONE; ++i)
+    {
+        node = child(node, rest[i]);
+    }
+
+    return node;
+}
@@ -0,0 +1,80 @@
+// WordDawg.hpp
+//
+// A WordDawg is a directed acyclic word graph: a trie of the words in a
+// dictionary in which identical subtrees (e.g., the "ING" endings shared
+// by many words) are stored only once.  Every node's outgoing edges are
+// stored contiguously and in order of their labels, so the whole graph is
+// a handful of flat arrays.
+//
+// As a SuggestionEngine, it finds every word within one edit of a given
+// word, by the same five rules as WordChecker::findSuggestions(), in a
+// single walk along the word's path through the graph.  At each position,
+// it tries each kind of edit, following only edges that actually exist,
+// then matches the rest of the word exactly; as soon as the word's own
+// path leaves the graph, no edit further along could produce a word, so
+// the walk stops there.
+
+#ifndef WORDDAWG_HPP
+#define WORDDAWG_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "SuggestionEngine.hpp"
+
+
+
+class WordDawg : public SuggestionEngine
+{
+public:
+    // Builds a WordDawg containing the given words, which can be in any
+    // order and can contain duplicates.
+    explicit WordDawg(std::vector<std::string> words);
+
+
+    // contains() returns true if the given word is in the WordDawg, false
+    // otherwise.  It runs in time proportional to the length of the word.
+    bool contains(std::string_view word) const;
+
+
+    // size() returns the number of distinct words in the WordDawg.
+    unsigned int size() const noexcept;
+
+
+    // nodeCount() returns the number of nodes in the graph, which is
+    // generally far fewer than the number of nodes in the equivalent trie.
+    unsigned int nodeCount() const noexcept;
+
+
+    // findSuggestions() returns every word that can be made from the given
+    // one by swapping an adjacent pair of characters, inserting a letter,
+    // deleting a character, or replacing a character with a letter, in
+    // order of the position at which the edit is made, followed by the
+    // word's splits into two words (see addSplits() in SuggestionEngine.hpp).
+    std::vector<std::string> findSuggestions(const std::string& word) const override;
+
+
+private:
+    static constexpr unsigned int NONE = static_cast<unsigned int>(-1);
+
+    struct Node
+    {
+        unsigned int firstEdge;
+        unsigned int edgeCount;
+        bool isWord;
+    };
+
+    unsigned int child(unsigned int node, char label) const noexcept;
+    unsigned int follow(unsigned int node, std::string_view rest) const noexcept;
+
+private:
+    std::vector<Node> nodes;
+    std::vector<char> edgeLabels;
+    std::vector<unsigned int> edgeTargets;
+    unsigned int root;
+    unsigned int wordCount;
+};
+
+
+
+#endif
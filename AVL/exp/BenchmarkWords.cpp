@@ -0,0 +1,101 @@
+// BenchmarkWords.cpp
+
+#include <random>
+#include <unordered_set>
+#include "BenchmarkWords.hpp"
+
+
+namespace
+{
+    const std::string CONSONANTS = "BCDFGHKLMNPRSTVW";
+    const std::string VOWELS = "AEIOU";
+    const std::string LETTERS = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+}
+
+
+std::vector<std::string> makeDictionary(
+    unsigned int count, unsigned int minLength, unsigned int maxLength, unsigned int seed)
+{
+    std::default_random_engine engine{seed};
+    std::uniform_int_distribution<unsigned int> length{minLength, maxLength};
+
+    std::unordered_set<std::string> seen;
+    std::vector<std::string> words;
+
+    while (words.size() < count)
+    {
+        std::string word(length(engine), ' ');
+        bool vowel = engine() % 2 == 0;
+
+        for (char& c : word)
+        {
+            const std::string& letters = vowel ? VOWELS : CONSONANTS;
+            c = letters[engine() % letters.size()];
+            vowel = !vowel;
+        }
+
+        if (seen.insert(word).second)
+        {
+            words.push_back(word);
+        }
+    }
+
+    return words;
+}
+
+
+std::vector<std::string> makeMisspellings(
+    const std::vector<std::string>& dictionary, unsigned int count, unsigned int seed)
+{
+    std::default_random_engine engine{seed};
+    std::vector<std::string> misspellings;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        std::string word = dictionary[engine() % dictionary.size()];
+        unsigned int position = engine() % word.size();
+        char letter = LETTERS[engine() % LETTERS.size()];
+
+        switch (engine() % 4)
+        {
+        case 0:
+            if (position + 1 < word.size())
+            {
+                std::swap(word[position], word[position + 1]);
+            }
+            break;
+
+        case 1:
+            word.insert(word.begin() + position, letter);
+            break;
+
+        case 2:
+            if (word.size() > 1)
+            {
+                word.erase(word.begin() + position);
+            }
+            break;
+
+        default:
+            word[position] = letter;
+            break;
+        }
+
+        misspellings.push_back(word);
+    }
+
+    return misspellings;
+}
+
+
+unsigned int fnv1aHash(const std::string& s)
+{
+    unsigned int hash = 2166136261u;
+
+    for (char c : s)
+    {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+
+    return hash;
+}
@@ -0,0 +1,34 @@
+// BenchmarkWords.hpp
+//
+// Synthetic word lists for the benchmarks.  Words are built from
+// alternating consonants and vowels, so that (as in a real dictionary)
+// many of them are within an edit or two of one another.
+
+#ifndef BENCHMARKWORDS_HPP
+#define BENCHMARKWORDS_HPP
+
+#include <string>
+#include <vector>
+
+
+
+// makeDictionary() returns the given number of distinct uppercase words,
+// between minLength and maxLength letters long, in no particular order.
+std::vector<std::string> makeDictionary(
+    unsigned int count, unsigned int minLength, unsigned int maxLength, unsigned int seed);
+
+
+// makeMisspellings() returns the given number of words, each made by
+// applying one random edit (swap, insertion, deletion, or replacement)
+// to a randomly-chosen word from the dictionary.
+std::vector<std::string> makeMisspellings(
+    const std::vector<std::string>& dictionary, unsigned int count, unsigned int seed);
+
+
+// fnv1aHash() is a simple, reasonable hash function for strings, for use
+// by HashSets in the benchmarks.
+unsigned int fnv1aHash(const std::string& s);
+
+
+
+#endif
@@ -0,0 +1,39 @@
+// Benchmarks.hpp
+//
+// Declares the benchmarks that expmain() can run.  Each one writes its
+// results, as a small table, to the given output stream.
+
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+#include <ostream>
+
+
+
+// Compares ConcurrentSkipListSet against a mutex-wrapped AVLSet as the
+// number of threads adding to and searching them grows.
+void runConcurrentSetBenchmark(std::ostream& out);
+
+
+// Compares findSuggestions() through the type-erased WordChecker with
+// BasicWordCheckers bound to a HashSet and an AVLSet.
+void runWordCheckerBenchmark(std::ostream& out);
+
+
+// Compares building each kind of Set from a text word list with loading
+// it in bulk from a BinaryDictionary.
+void runDictionaryLoadBenchmark(std::ostream& out);
+
+
+// Compares deduplicating suggestions by searching the vector of them
+// with using a hash index, on short words with hundreds of hits.
+void runSuggestionDedupBenchmark(std::ostream& out);
+
+
+// Compares findSuggestions() generating and probing every candidate edit
+// with each of the alternative SuggestionEngines.
+void runSuggestionEngineBenchmark(std::ostream& out);
+
+
+
+#endif
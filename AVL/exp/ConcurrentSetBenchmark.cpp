@@ -0,0 +1,124 @@
+// ConcurrentSetBenchmark.cpp
+//
+// Each thread adds its share of a fixed number of random keys and then
+// searches for the same number of random keys, half of which are present.
+// Throughput is reported in millions of operations per second.
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "ConcurrentSkipListSet.hpp"
+
+
+namespace
+{
+    constexpr unsigned int OPERATIONS_PER_RUN = 1000000;
+
+
+    class LockedAVLSet
+    {
+    public:
+        void add(int element)
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            set.add(element);
+        }
+
+        bool contains(int element) const
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            return set.contains(element);
+        }
+
+    private:
+        mutable std::mutex mutex;
+        AVLSet<int> set;
+    };
+
+
+    template <typename SetType>
+    double measureThroughput(unsigned int threadCount)
+    {
+        SetType set;
+        unsigned int perThread = OPERATIONS_PER_RUN / 2 / threadCount;
+
+        std::vector<std::vector<int>> keys(threadCount);
+
+        for (unsigned int t = 0; t < threadCount; ++t)
+        {
+            std::default_random_engine engine{t};
+            std::uniform_int_distribution<int> distribution{0, 1 << 30};
+
+            keys[t].resize(perThread);
+            std::generate(keys[t].begin(), keys[t].end(), [&] { return distribution(engine) * 2; });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+
+        for (unsigned int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back(
+                [&set, &keys, t]
+                {
+                    for (int key : keys[t])
+                    {
+                        set.add(key);
+                    }
+
+                    unsigned int found = 0;
+
+                    for (int key : keys[t])
+                    {
+                        found += set.contains(key) + set.contains(key + 1);
+                    }
+
+                    volatile unsigned int sink = found;
+                    (void) sink;
+                });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return perThread * threadCount * 3 / elapsed.count() / 1e6;
+    }
+}
+
+
+void runConcurrentSetBenchmark(std::ostream& out)
+{
+    unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    out << std::setw(8) << "threads"
+        << std::setw(22) << "lock-free (Mops/s)"
+        << std::setw(22) << "locked AVL (Mops/s)" << std::endl;
+
+    // The thread counts double from 1, ending with every core even when
+    // the number of cores isn't a power of 2.
+    std::vector<unsigned int> threadCounts;
+
+    for (unsigned int threads = 1; threads < maxThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+
+    threadCounts.push_back(maxThreads);
+
+    for (unsigned int threads : threadCounts)
+    {
+        out << std::setw(8) << threads << std::fixed << std::setprecision(2)
+            << std::setw(22) << measureThroughput<ConcurrentSkipListSet<int>>(threads)
+            << std::setw(22) << measureThroughput<LockedAVLSet>(threads) << std::endl;
+    }
+}
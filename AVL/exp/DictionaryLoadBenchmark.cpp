@@ -0,0 +1,107 @@
+// DictionaryLoadBenchmark.cpp
+//
+// Compares building each kind of Set from a text word list, one word at a
+// time, with building it from the same words in a BinaryDictionary file,
+// in bulk.  Both files are written to the temporary directory first, and
+// the times include reading them.
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "BenchmarkWords.hpp"
+#include "Benchmarks.hpp"
+#include "BinaryDictionary.hpp"
+#include "HashSet.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    constexpr unsigned int WORD_COUNT = 1000000;
+
+
+    template <typename Function>
+    double timeMilliseconds(Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count();
+    }
+
+
+    template <typename SetType>
+    void loadText(const std::string& path, SetType& set)
+    {
+        std::ifstream in{path};
+        std::string word;
+
+        while (std::getline(in, word))
+        {
+            set.add(word);
+        }
+    }
+
+
+    template <typename MakeSet>
+    void compare(
+        std::ostream& out, const std::string& name, MakeSet makeSet,
+        const std::string& textPath, const std::string& binaryPath)
+    {
+        // The sets are destroyed after they're timed, since that takes a
+        // while and isn't part of loading.
+        auto textSet = makeSet();
+        double text = timeMilliseconds([&] { loadText(textPath, textSet); });
+
+        auto binarySet = makeSet();
+        double binary = timeMilliseconds([&] { BinaryDictionary{binaryPath}.loadInto(binarySet); });
+
+        out << std::setw(14) << name << std::fixed << std::setprecision(1)
+            << std::setw(14) << text
+            << std::setw(14) << binary
+            << std::setw(10) << text / binary << "x" << std::endl;
+    }
+}
+
+
+void runDictionaryLoadBenchmark(std::ostream& out)
+{
+    std::vector<std::string> dictionary = makeDictionary(WORD_COUNT, 3, 12, 52);
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+    std::string textPath = (directory / "dictionary-load-benchmark.txt").string();
+    std::string binaryPath = (directory / "dictionary-load-benchmark.bin").string();
+
+    {
+        std::ofstream text{textPath};
+
+        for (const std::string& word : dictionary)
+        {
+            text << word << '\n';
+        }
+    }
+
+    BinaryDictionary::write(binaryPath, dictionary);
+
+    out << WORD_COUNT << " words" << std::endl;
+    out << std::setw(14) << "set"
+        << std::setw(14) << "text (ms)"
+        << std::setw(14) << "binary (ms)"
+        << std::setw(11) << "speedup" << std::endl;
+
+    compare(
+        out, "HashSet",
+        [] { return HashSet<std::string>{[](const std::string& s) { return BinaryDictionary::hash(s); }}; },
+        textPath, binaryPath);
+
+    compare(out, "AVLSet", [] { return AVLSet<std::string>{}; }, textPath, binaryPath);
+    compare(out, "SkipListSet", [] { return SkipListSet<std::string>{}; }, textPath, binaryPath);
+
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(binaryPath);
+}
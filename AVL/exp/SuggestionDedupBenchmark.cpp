@@ -0,0 +1,188 @@
+// SuggestionDedupBenchmark.cpp
+//
+// Short words against a dense dictionary (here, every word of one to four
+// letters) are the worst case for deduplicating suggestions: nearly every
+// candidate is a word, so there are hundreds of hits, many of them
+// repeated.  This benchmark collects the stream of hits for a batch of
+// such words and times deduplicating it by searching the vector of
+// suggestions so far, as findSuggestions() used to, and with the
+// impl_::SuggestionIndex it uses now.
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "BenchmarkWords.hpp"
+#include "HashSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    const std::string LETTERS = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+
+    void addAllWords(HashSet<std::string>& words, std::string& prefix, unsigned int length)
+    {
+        if (prefix.size() == length)
+        {
+            words.add(prefix);
+            return;
+        }
+
+        for (char letter : LETTERS)
+        {
+            prefix.push_back(letter);
+            addAllWords(words, prefix, length);
+            prefix.pop_back();
+        }
+    }
+
+
+    // Returns every candidate findSuggestions() would generate for the
+    // given word that is in the set, in the order it would generate them,
+    // duplicates included.
+    std::vector<std::string> hitsFor(const HashSet<std::string>& words, const std::string& word)
+    {
+        std::vector<std::string> hits;
+
+        auto probe =
+            [&](const std::string& candidate)
+            {
+                if (words.contains(candidate))
+                {
+                    hits.push_back(candidate);
+                }
+            };
+
+        for (std::size_t i = 0; i + 1 < word.size(); ++i)
+        {
+            std::string candidate = word;
+            std::swap(candidate[i], candidate[i + 1]);
+            probe(candidate);
+        }
+
+        for (std::size_t i = 0; i <= word.size(); ++i)
+        {
+            for (char letter : LETTERS)
+            {
+                probe(word.substr(0, i) + letter + word.substr(i));
+            }
+        }
+
+        for (std::size_t i = 0; i < word.size(); ++i)
+        {
+            probe(word.substr(0, i) + word.substr(i + 1));
+        }
+
+        for (std::size_t i = 0; i < word.size(); ++i)
+        {
+            for (char letter : LETTERS)
+            {
+                std::string candidate = word;
+                candidate[i] = letter;
+                probe(candidate);
+            }
+        }
+
+        for (std::size_t i = 1; i < word.size(); ++i)
+        {
+            if (words.contains(word.substr(0, i)) && words.contains(word.substr(i)))
+            {
+                hits.push_back(word.substr(0, i) + " " + word.substr(i));
+            }
+        }
+
+        return hits;
+    }
+
+
+    template <typename Dedup>
+    double measureMicroseconds(const std::vector<std::vector<std::string>>& streams, Dedup dedup)
+    {
+        unsigned int kept = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (const std::vector<std::string>& stream : streams)
+        {
+            kept += dedup(stream).size();
+        }
+
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+        volatile unsigned int sink = kept;
+        (void) sink;
+
+        return elapsed.count() / streams.size();
+    }
+}
+
+
+void runSuggestionDedupBenchmark(std::ostream& out)
+{
+    HashSet<std::string> words{fnv1aHash};
+    std::string prefix;
+
+    for (unsigned int length = 1; length <= 4; ++length)
+    {
+        addAllWords(words, prefix, length);
+    }
+
+    std::default_random_engine engine{33};
+    std::vector<std::vector<std::string>> streams;
+    std::size_t totalHits = 0;
+
+    for (unsigned int i = 0; i < 2000; ++i)
+    {
+        std::string word(2 + engine() % 2, ' ');
+
+        for (char& c : word)
+        {
+            c = LETTERS[engine() % LETTERS.size()];
+        }
+
+        streams.push_back(hitsFor(words, word));
+        totalHits += streams.back().size();
+    }
+
+    double linear = measureMicroseconds(
+        streams,
+        [](const std::vector<std::string>& stream)
+        {
+            std::vector<std::string> suggestions;
+
+            for (const std::string& hit : stream)
+            {
+                if (std::find(suggestions.begin(), suggestions.end(), hit) == suggestions.end())
+                {
+                    suggestions.push_back(hit);
+                }
+            }
+
+            return suggestions;
+        });
+
+    double hashed = measureMicroseconds(
+        streams,
+        [](const std::vector<std::string>& stream)
+        {
+            std::vector<std::string> suggestions;
+            impl_::SuggestionIndex index{suggestions};
+
+            for (const std::string& hit : stream)
+            {
+                index.addIfNew(hit);
+            }
+
+            return suggestions;
+        });
+
+    out << "hits per word: " << totalHits / streams.size() << std::endl;
+    out << std::fixed << std::setprecision(2)
+        << "linear search dedup: " << linear << " us/word" << std::endl
+        << "hash index dedup:    " << hashed << " us/word" << std::endl;
+}
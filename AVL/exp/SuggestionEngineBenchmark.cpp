@@ -0,0 +1,118 @@
+// SuggestionEngineBenchmark.cpp
+//
+// Compares the time findSuggestions() takes when a WordChecker generates
+// every candidate edit and probes a HashSet for it, with the time taken
+// by each of the alternative SuggestionEngines, on the same dictionary
+// and misspellings.  Engines that find words further away than one edit
+// naturally find more suggestions, and take longer to do it.
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+#include "BKTree.hpp"
+#include "BenchmarkWords.hpp"
+#include "DeletionIndex.hpp"
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "SortedWordList.hpp"
+#include "WordChecker.hpp"
+#include "WordDawg.hpp"
+
+
+namespace
+{
+    // Returns the time, in microseconds, that the given function takes.
+    template <typename Function>
+    double timeMicroseconds(Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count();
+    }
+
+
+    // Reports the average time per query, and the total number of
+    // suggestions found, using the given engine (or generate-and-probe,
+    // if there isn't one).
+    void measure(
+        std::ostream& out, const std::string& name, const HashSet<std::string>& words,
+        const SuggestionEngine* engine, const std::vector<std::string>& queries)
+    {
+        BasicWordChecker<HashSet<std::string>> checker{words};
+        checker.setSuggestionEngine(engine);
+
+        unsigned int found = 0;
+
+        double elapsed = timeMicroseconds(
+            [&]
+            {
+                for (const std::string& query : queries)
+                {
+                    found += checker.findSuggestions(query).size();
+                }
+            });
+
+        out << std::setw(24) << name << std::fixed << std::setprecision(2)
+            << std::setw(14) << elapsed / queries.size()
+            << std::setw(14) << found << std::endl;
+    }
+}
+
+
+void runSuggestionEngineBenchmark(std::ostream& out)
+{
+    std::vector<std::string> dictionary = makeDictionary(100000, 3, 10, 50);
+    std::vector<std::string> queries = makeMisspellings(dictionary, 1000, 51);
+
+    HashSet<std::string> words{fnv1aHash};
+
+    for (const std::string& word : dictionary)
+    {
+        words.add(word);
+    }
+
+    std::unique_ptr<WordDawg> dawg;
+
+    double dawgBuild = timeMicroseconds([&] { dawg = std::make_unique<WordDawg>(dictionary); });
+
+    out << "WordDawg: " << dawg->nodeCount() << " nodes, built in "
+        << std::fixed << std::setprecision(1) << dawgBuild / 1000.0 << " ms" << std::endl;
+
+    std::unique_ptr<DeletionIndex> deletionIndex;
+
+    double deletionIndexBuild = timeMicroseconds(
+        [&] { deletionIndex = std::make_unique<DeletionIndex>(dictionary, 2); });
+
+    out << "DeletionIndex (k = 2): " << deletionIndex->deletionCount() << " deletions, "
+        << std::setprecision(1) << deletionIndex->memoryUsage() / (1024.0 * 1024.0) << " MB, built in "
+        << deletionIndexBuild / 1000.0 << " ms" << std::endl;
+
+    std::unique_ptr<BKTree> bkTree;
+
+    double bkTreeBuild = timeMicroseconds(
+        [&] { bkTree = std::make_unique<BKTree>(dictionary, 1); });
+
+    out << "BKTree: depth " << bkTree->depth() << ", built in "
+        << bkTreeBuild / 1000.0 << " ms" << std::endl;
+
+    std::unique_ptr<SortedWordList> sortedWordList;
+
+    double sortedWordListBuild = timeMicroseconds(
+        [&] { sortedWordList = std::make_unique<SortedWordList>(dictionary, 1); });
+
+    out << "SortedWordList: built in " << sortedWordListBuild / 1000.0 << " ms" << std::endl;
+
+    out << std::setw(24) << "engine"
+        << std::setw(14) << "query (us)"
+        << std::setw(14) << "suggestions" << std::endl;
+
+    measure(out, "generate-and-probe", words, nullptr, queries);
+    measure(out, "WordDawg", words, dawg.get(), queries);
+    measure(out, "BKTree (k = 1)", words, bkTree.get(), queries);
+    measure(out, "SortedWordList (k = 1)", words, sortedWordList.get(), queries);
+    measure(out, "DeletionIndex (k = 2)", words, deletionIndex.get(), queries);
+}
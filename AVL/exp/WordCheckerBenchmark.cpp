@@ -0,0 +1,93 @@
+// WordCheckerBenchmark.cpp
+//
+// Measures how long findSuggestions() takes on a batch of misspellings
+// when the WordChecker looks words up through the type-erased Set
+// interface (a virtual call per lookup), compared to a BasicWordChecker
+// bound statically to the same concrete set.
+
+#include <chrono>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "BenchmarkWords.hpp"
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    constexpr unsigned int RUNS = 3;
+
+
+    // Returns the average time per query, in microseconds, of the fastest
+    // of several runs.
+    template <typename Checker>
+    double measureMicroseconds(const Checker& checker, const std::vector<std::string>& queries)
+    {
+        double best = 0.0;
+
+        for (unsigned int run = 0; run < RUNS; ++run)
+        {
+            unsigned int found = 0;
+
+            auto start = std::chrono::steady_clock::now();
+
+            for (const std::string& query : queries)
+            {
+                found += checker.findSuggestions(query).size();
+            }
+
+            std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+            volatile unsigned int sink = found;
+            (void) sink;
+
+            if (run == 0 || elapsed.count() < best)
+            {
+                best = elapsed.count();
+            }
+        }
+
+        return best / queries.size();
+    }
+
+
+    template <typename SetType>
+    void compare(std::ostream& out, const std::string& name, const SetType& set,
+                 const std::vector<std::string>& queries)
+    {
+        double erased = measureMicroseconds(WordChecker{set}, queries);
+        double bound = measureMicroseconds(BasicWordChecker<SetType>{set}, queries);
+
+        out << std::setw(10) << name << std::fixed << std::setprecision(2)
+            << std::setw(16) << erased
+            << std::setw(16) << bound
+            << std::setw(10) << erased / bound << "x" << std::endl;
+    }
+}
+
+
+void runWordCheckerBenchmark(std::ostream& out)
+{
+    std::vector<std::string> dictionary = makeDictionary(100000, 3, 10, 46);
+    std::vector<std::string> queries = makeMisspellings(dictionary, 5000, 47);
+
+    HashSet<std::string> hashSet{fnv1aHash};
+    AVLSet<std::string> avlSet;
+
+    for (const std::string& word : dictionary)
+    {
+        hashSet.add(word);
+        avlSet.add(word);
+    }
+
+    out << std::setw(10) << "set"
+        << std::setw(16) << "virtual (us)"
+        << std::setw(16) << "bound (us)"
+        << std::setw(11) << "speedup" << std::endl;
+
+    compare(out, "HashSet", hashSet, queries);
+    compare(out, "AVLSet", avlSet, queries);
+}
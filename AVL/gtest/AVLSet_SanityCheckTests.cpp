@@ -0,0 +1,96 @@
+// AVLSet_SanityCheckTests.cpp
+
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+
+
+namespace
+{
+    // A Fragile counts how many of it are alive, and can't be made from
+    // the number FRAGILE.
+    struct Fragile
+    {
+        static constexpr int FRAGILE = 2222;
+        static std::atomic<int> alive;
+
+        int value;
+
+        Fragile(int value)
+            : value{value}
+        {
+            if (value == FRAGILE)
+            {
+                throw std::runtime_error{"fragile"};
+            }
+
+            ++alive;
+        }
+
+        Fragile(const Fragile& f)
+            : value{f.value}
+        {
+            ++alive;
+        }
+
+        ~Fragile()
+        {
+            --alive;
+        }
+
+        bool operator==(const Fragile& f) const { return value == f.value; }
+        bool operator<(const Fragile& f) const { return value < f.value; }
+        bool operator>(const Fragile& f) const { return value > f.value; }
+    };
+
+
+    std::atomic<int> Fragile::alive{0};
+}
+
+
+TEST(AVLSet_SanityCheckTests, assignSortedBuildsABalancedTree)
+{
+    std::vector<int> values(10000);
+    std::iota(values.begin(), values.end(), 0);
+
+    for (unsigned int threadCount : {1u, 4u})
+    {
+        AVLSet<int> s;
+        s.assignSorted(values.begin(), values.end(), threadCount);
+
+        ASSERT_EQ(10000, s.size());
+        ASSERT_EQ(13, s.height());
+        ASSERT_TRUE(s.contains(0));
+        ASSERT_TRUE(s.contains(9999));
+        ASSERT_FALSE(s.contains(10000));
+    }
+}
+
+
+TEST(AVLSet_SanityCheckTests, assignSortedFreesEverythingWhenAnElementCannotBeMade)
+{
+    std::vector<int> values(10000);
+    std::iota(values.begin(), values.end(), 0);
+
+    // The fragile element is made on a thread other than the first one
+    // when there are several of them.
+    for (unsigned int threadCount : {1u, 4u})
+    {
+        {
+            AVLSet<Fragile> s;
+            s.assignSorted(values.begin(), values.begin() + 10, threadCount);
+            ASSERT_EQ(10, Fragile::alive);
+
+            ASSERT_THROW({ s.assignSorted(values.begin(), values.end(), threadCount); }, std::runtime_error);
+            ASSERT_EQ(0, s.size());
+            ASSERT_EQ(-1, s.height());
+            ASSERT_FALSE(s.contains(Fragile{5}));
+        }
+
+        ASSERT_EQ(0, Fragile::alive);
+    }
+}
@@ -0,0 +1,65 @@
+// BKTree_SanityCheckTests.cpp
+
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BKTree.hpp"
+#include "RandomWords.hpp"
+
+
+TEST(BKTree_SanityCheckTests, containsExactlyTheDistinctWords)
+{
+    BKTree tree{{"CAT", "DOG", "CAT", ""}, 1};
+
+    ASSERT_EQ(3, tree.size());
+    ASSERT_EQ(1, tree.maxDistance());
+    ASSERT_TRUE(tree.contains("CAT"));
+    ASSERT_TRUE(tree.contains(""));
+    ASSERT_FALSE(tree.contains("CA"));
+
+    BKTree empty{{}};
+    ASSERT_EQ(0, empty.size());
+    ASSERT_TRUE(empty.findWithin("CAT", 3).empty());
+}
+
+
+TEST(BKTree_SanityCheckTests, findWithinAgreesWithEditDistanceOnRandomDictionaries)
+{
+    std::mt19937 random{36};
+
+    for (int trial = 0; trial < 30; ++trial)
+    {
+        std::vector<std::string> words = randomWords(random, "ABCD", 6, 5 + trial * 4);
+        BKTree tree{words, 1};
+
+        for (int i = 0; i < 20; ++i)
+        {
+            std::string word = randomWord(random, "ABCDE", 7);
+
+            for (unsigned int distance = 0; distance <= 4; ++distance)
+            {
+                ASSERT_EQ(wordsWithin(words, word, distance), tree.findWithin(word, distance));
+            }
+
+            unsigned int maxDistance = i % 3 + 1;
+            tree.setMaxDistance(maxDistance);
+
+            std::vector<std::string> expected;
+
+            for (auto& [w, distance] : wordsWithin(words, word, maxDistance))
+            {
+                expected.push_back(w);
+            }
+
+            for (std::string& split : splitsWithin(words, word))
+            {
+                expected.push_back(split);
+            }
+
+            ASSERT_EQ(expected, tree.findSuggestions(word));
+        }
+    }
+}
@@ -0,0 +1,184 @@
+// BinaryDictionary_SanityCheckTests.cpp
+
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BinaryDictionary.hpp"
+
+
+namespace
+{
+    // The header is 32 bytes, with the flags 12 bytes in, and is followed
+    // by the offsets.
+    constexpr std::streamoff FLAGS_POSITION = 12;
+    constexpr std::streamoff OFFSETS_POSITION = 32;
+
+
+    std::string temporaryPath(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("BinaryDictionary_SanityCheckTests_" + name)).string();
+    }
+
+
+    // overwrite() replaces the bytes of the given file, starting at the
+    // given position, with the given ones.
+    void overwrite(const std::string& path, std::streamoff position, std::string_view bytes)
+    {
+        std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+        file.seekp(position);
+        file.write(bytes.data(), bytes.size());
+    }
+
+
+    void overwrite(const std::string& path, std::streamoff position, std::uint32_t value)
+    {
+        overwrite(path, position, std::string_view{reinterpret_cast<const char*>(&value), sizeof(value)});
+    }
+
+
+    // The words used by most of the tests, which only one sort of set
+    // would find in the same order.
+    const std::vector<std::string> WORDS{"PEAR", "APPLE", "FIG", "", "APPLE", "KIWI", "BANANA", "FIG"};
+    const std::vector<std::string> SORTED_WORDS{"", "APPLE", "BANANA", "FIG", "KIWI", "PEAR"};
+}
+
+
+TEST(BinaryDictionary_SanityCheckTests, writtenWordsCanBeReadBack)
+{
+    std::string path = temporaryPath("roundTrip");
+
+    BinaryDictionary::write(path, WORDS);
+    BinaryDictionary sorted{path};
+
+    ASSERT_TRUE(sorted.isSorted());
+    ASSERT_EQ(SORTED_WORDS.size(), sorted.size());
+
+    for (unsigned int i = 0; i < sorted.size(); ++i)
+    {
+        ASSERT_EQ(SORTED_WORDS[i], sorted.word(i));
+        ASSERT_EQ(BinaryDictionary::hash(SORTED_WORDS[i]), sorted.wordHash(i));
+    }
+
+    // Unsorted, the first copy of each word is kept where it was.
+    BinaryDictionary::write(path, WORDS, false);
+    BinaryDictionary unsorted{path};
+
+    std::vector<std::string> expected{"PEAR", "APPLE", "FIG", "", "KIWI", "BANANA"};
+
+    ASSERT_FALSE(unsorted.isSorted());
+    ASSERT_EQ(expected.size(), unsorted.size());
+
+    for (unsigned int i = 0; i < unsorted.size(); ++i)
+    {
+        ASSERT_EQ(expected[i], unsorted.word(i));
+    }
+
+    std::vector<std::string_view> words = unsorted.sortedWords();
+    ASSERT_EQ(SORTED_WORDS, std::vector<std::string>(words.begin(), words.end()));
+
+    std::filesystem::remove(path);
+}
+
+
+TEST(BinaryDictionary_SanityCheckTests, corruptFilesAreRejected)
+{
+    std::string path = temporaryPath("corrupt");
+
+    ASSERT_THROW({ BinaryDictionary dictionary{path + ".missing"}; }, BinaryDictionaryException);
+
+    BinaryDictionary::write(path, {"AB", "CD", "EF"});
+    overwrite(path, 0, "WORDDICK");
+    ASSERT_THROW({ BinaryDictionary dictionary{path}; }, BinaryDictionaryException);
+
+    BinaryDictionary::write(path, {"AB", "CD", "EF"});
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    ASSERT_THROW({ BinaryDictionary dictionary{path}; }, BinaryDictionaryException);
+
+    // The second word's end is past the end of the text.
+    BinaryDictionary::write(path, {"AB", "CD", "EF"});
+    overwrite(path, OFFSETS_POSITION + 2 * 4, 7);
+    ASSERT_THROW({ BinaryDictionary dictionary{path}; }, BinaryDictionaryException);
+
+    // A file that says it's sorted has to be, with no duplicates.
+    BinaryDictionary::write(path, {"CD", "AB", "EF"}, false);
+    overwrite(path, FLAGS_POSITION, 1);
+    ASSERT_THROW({ BinaryDictionary dictionary{path}; }, BinaryDictionaryException);
+
+    BinaryDictionary::write(path, {"AB", "CD", "EF"});
+    overwrite(path, std::filesystem::file_size(path) - 4, "AB");
+    ASSERT_THROW({ BinaryDictionary dictionary{path}; }, BinaryDictionaryException);
+
+    // Unsorted ones can be in any order.
+    BinaryDictionary::write(path, {"CD", "AB", "EF"}, false);
+    ASSERT_NO_THROW({ BinaryDictionary dictionary{path}; });
+
+    std::filesystem::remove(path);
+}
+
+
+TEST(BinaryDictionary_SanityCheckTests, canLoadIntoEachKindOfSet)
+{
+    std::string path = temporaryPath("load");
+
+    for (bool sort : {true, false})
+    {
+        BinaryDictionary::write(path, WORDS, sort);
+        BinaryDictionary dictionary{path};
+
+        for (unsigned int threadCount : {1u, 3u})
+        {
+            HashSet<std::string> hashSet{[](const std::string& word) { return BinaryDictionary::hash(word); }};
+            AVLSet<std::string> avlSet;
+            SkipListSet<std::string> skipListSet;
+            SkipListSet<std::string, true> indexedSkipListSet;
+
+            dictionary.loadInto(hashSet, threadCount);
+            dictionary.loadInto(avlSet, threadCount);
+            dictionary.loadInto(skipListSet, threadCount);
+            dictionary.loadInto(indexedSkipListSet, threadCount);
+
+            ASSERT_EQ(SORTED_WORDS.size(), hashSet.size());
+            ASSERT_EQ(SORTED_WORDS.size(), avlSet.size());
+            ASSERT_EQ(SORTED_WORDS.size(), skipListSet.size());
+            ASSERT_EQ(SORTED_WORDS.size(), indexedSkipListSet.size());
+
+            for (unsigned int i = 0; i < SORTED_WORDS.size(); ++i)
+            {
+                ASSERT_TRUE(hashSet.contains(SORTED_WORDS[i]));
+                ASSERT_TRUE(avlSet.contains(SORTED_WORDS[i]));
+                ASSERT_TRUE(skipListSet.contains(SORTED_WORDS[i]));
+                ASSERT_EQ(SORTED_WORDS[i], indexedSkipListSet.select(i));
+            }
+
+            ASSERT_FALSE(hashSet.contains("GRAPE"));
+            ASSERT_FALSE(avlSet.contains("GRAPE"));
+            ASSERT_FALSE(skipListSet.contains("GRAPE"));
+        }
+    }
+
+    std::filesystem::remove(path);
+}
+
+
+TEST(BinaryDictionary_SanityCheckTests, loadingIntoAHashSetWithTheWrongHashFunctionLeavesItEmpty)
+{
+    std::string path = temporaryPath("wrongHash");
+
+    BinaryDictionary::write(path, WORDS);
+    BinaryDictionary dictionary{path};
+
+    HashSet<std::string> set{[](const std::string& word) { return static_cast<unsigned int>(word.size()); }};
+    set.add("MANGO");
+
+    ASSERT_THROW({ dictionary.loadInto(set); }, BinaryDictionaryException);
+    ASSERT_EQ(0, set.size());
+    ASSERT_FALSE(set.contains("APPLE"));
+    ASSERT_FALSE(set.contains("MANGO"));
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,127 @@
+// ConcurrentSkipListSet_SanityCheckTests.cpp
+
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ConcurrentSkipListSet.hpp"
+
+
+TEST(ConcurrentSkipListSet_SanityCheckTests, canAddFindAndRemoveElements)
+{
+    ConcurrentSkipListSet<int> s1;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s1.add(i * 7 % 100);
+    }
+
+    s1.add(42);
+
+    ASSERT_EQ(100, s1.size());
+    ASSERT_TRUE(s1.contains(0));
+    ASSERT_TRUE(s1.contains(99));
+    ASSERT_FALSE(s1.contains(100));
+
+    for (int i = 0; i < 100; i += 2)
+    {
+        ASSERT_TRUE(s1.remove(i));
+    }
+
+    ASSERT_FALSE(s1.remove(42));
+    ASSERT_FALSE(s1.remove(100));
+    ASSERT_EQ(50, s1.size());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(i % 2 != 0, s1.contains(i));
+    }
+
+    std::vector<int> visited;
+    s1.forEach([&](int element) { visited.push_back(element); });
+
+    ASSERT_EQ(50, visited.size());
+    ASSERT_TRUE(std::is_sorted(visited.begin(), visited.end()));
+
+    s1.add(42);
+    ASSERT_TRUE(s1.contains(42));
+    ASSERT_EQ(51, s1.size());
+}
+
+
+TEST(ConcurrentSkipListSet_SanityCheckTests, concurrentAddsAndRemovesLeaveTheRightElements)
+{
+    constexpr int threadCount = 4;
+    constexpr int perThread = 5000;
+
+    ConcurrentSkipListSet<int> s1;
+    std::atomic<int> removed{0};
+    std::vector<std::thread> threads;
+
+    // First, every thread adds the same elements, in different orders.
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back(
+            [&s1, t]
+            {
+                for (int i = 0; i < perThread; ++i)
+                {
+                    s1.add((i * 31 + t * 17) % perThread);
+                }
+            });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(perThread, s1.size());
+    threads.clear();
+
+    // Then every thread races the others to remove the odd elements, so
+    // each must be removed exactly once, while adding elements of its own
+    // beyond the others' and searching for the even ones, which survive.
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back(
+            [&s1, &removed, t]
+            {
+                for (int i = 1; i < perThread; i += 2)
+                {
+                    removed += s1.remove(i);
+                    s1.add(perThread * (t + 1) + i);
+                    s1.contains(i - 1);
+                }
+            });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(perThread / 2, removed.load());
+    ASSERT_EQ(perThread / 2 * (threadCount + 1), s1.size());
+
+    for (int i = 0; i < perThread; ++i)
+    {
+        ASSERT_EQ(i % 2 == 0, s1.contains(i));
+        ASSERT_EQ(i % 2 != 0, s1.contains(perThread * threadCount + i));
+    }
+
+    int previous = -1;
+    unsigned int visited = 0;
+
+    s1.forEach(
+        [&](int element)
+        {
+            ASSERT_LT(previous, element);
+            previous = element;
+            ++visited;
+        });
+
+    ASSERT_EQ(s1.size(), visited);
+}
@@ -0,0 +1,62 @@
+// DeletionIndex_SanityCheckTests.cpp
+
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "DeletionIndex.hpp"
+#include "RandomWords.hpp"
+
+
+TEST(DeletionIndex_SanityCheckTests, containsExactlyTheDistinctWords)
+{
+    DeletionIndex index{{"CAT", "DOG", "CAT", ""}, 1};
+
+    ASSERT_EQ(3, index.size());
+    ASSERT_EQ(1, index.maxDistance());
+    ASSERT_TRUE(index.contains("CAT"));
+    ASSERT_TRUE(index.contains(""));
+    ASSERT_FALSE(index.contains("CA"));
+}
+
+
+TEST(DeletionIndex_SanityCheckTests, findWithinAgreesWithEditDistanceOnRandomDictionaries)
+{
+    std::mt19937 random{35};
+
+    for (int trial = 0; trial < 30; ++trial)
+    {
+        std::vector<std::string> words = randomWords(random, "ABCD", 6, 5 + trial * 4);
+        unsigned int maxDistance = trial % 3 + 1;
+        DeletionIndex index{words, maxDistance};
+
+        for (int i = 0; i < 20; ++i)
+        {
+            std::string word = randomWord(random, "ABCDE", 7);
+
+            for (unsigned int distance = 0; distance <= maxDistance; ++distance)
+            {
+                ASSERT_EQ(wordsWithin(words, word, distance), index.findWithin(word, distance));
+            }
+
+            // A distance beyond the index's maximum is limited to it.
+            ASSERT_EQ(wordsWithin(words, word, maxDistance), index.findWithin(word, maxDistance + 1));
+
+            std::vector<std::string> expected;
+
+            for (auto& [w, distance] : wordsWithin(words, word, maxDistance))
+            {
+                expected.push_back(w);
+            }
+
+            for (std::string& split : splitsWithin(words, word))
+            {
+                expected.push_back(split);
+            }
+
+            ASSERT_EQ(expected, index.findSuggestions(word));
+        }
+    }
+}
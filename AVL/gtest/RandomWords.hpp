@@ -0,0 +1,106 @@
+// RandomWords.hpp
+//
+// Random dictionaries for the suggestion engines' tests, and the
+// brute-force answers that the engines are checked against.
+
+#ifndef RANDOMWORDS_HPP
+#define RANDOMWORDS_HPP
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Levenshtein.hpp"
+
+
+
+// randomWord() returns a word of up to maxLength characters, each one
+// chosen at random from the given letters.
+inline std::string randomWord(std::mt19937& random, const std::string& letters, unsigned int maxLength)
+{
+    std::string word(random() % (maxLength + 1), ' ');
+
+    for (char& c : word)
+    {
+        c = letters[random() % letters.size()];
+    }
+
+    return word;
+}
+
+
+// randomWords() returns count words made by randomWord(), which can
+// include duplicates.
+inline std::vector<std::string> randomWords(
+    std::mt19937& random, const std::string& letters, unsigned int maxLength, unsigned int count)
+{
+    std::vector<std::string> words;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        words.push_back(randomWord(random, letters, maxLength));
+    }
+
+    return words;
+}
+
+
+// wordsWithin() returns the distinct words within the given edit distance
+// of the given word, along with their distances, nearest first and
+// alphabetically among words at the same distance, by measuring the
+// distance to every one of them.
+inline std::vector<std::pair<std::string, unsigned int>> wordsWithin(
+    std::vector<std::string> words, std::string_view word, unsigned int distance)
+{
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    std::vector<std::pair<std::string, unsigned int>> found;
+
+    for (const std::string& w : words)
+    {
+        unsigned int d = levenshteinDistance(word, w);
+
+        if (d <= distance)
+        {
+            found.emplace_back(w, d);
+        }
+    }
+
+    std::stable_sort(
+        found.begin(), found.end(),
+        [](const auto& a, const auto& b)
+        {
+            return a.second < b.second;
+        });
+
+    return found;
+}
+
+
+// splitsWithin() returns every way of splitting the given word into two
+// of the given words, separated by a space, in order of where it's split.
+inline std::vector<std::string> splitsWithin(const std::vector<std::string>& words, const std::string& word)
+{
+    std::vector<std::string> splits;
+
+    for (std::size_t i = 1; i < word.size(); ++i)
+    {
+        std::string first = word.substr(0, i);
+        std::string second = word.substr(i);
+
+        if (std::find(words.begin(), words.end(), first) != words.end()
+            && std::find(words.begin(), words.end(), second) != words.end())
+        {
+            splits.push_back(first + " " + second);
+        }
+    }
+
+    return splits;
+}
+
+
+
+#endif
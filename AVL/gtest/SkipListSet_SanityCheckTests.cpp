@@ -0,0 +1,238 @@
+// SkipListSet_SanityCheckTests.cpp
+
+
+#include <iterator>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    template <bool Indexed = false>
+    SkipListSet<int, Indexed> makeSet(double promotionProbability, unsigned int maxLevel = 31)
+    {
+        return SkipListSet<int, Indexed>{
+            std::make_unique<GeometricSkipListLevelTester<int>>(promotionProbability, maxLevel)};
+    }
+
+
+    // matches() returns true if the given indexed set holds exactly the
+    // elements of the given std::set, as select() finds them.
+    testing::AssertionResult matches(const SkipListSet<int, true>& s, const std::set<int>& expected)
+    {
+        if (s.size() != expected.size())
+        {
+            return testing::AssertionFailure() << "size " << s.size() << ", not " << expected.size();
+        }
+
+        unsigned int index = 0;
+
+        for (int element : expected)
+        {
+            if (s.select(index) != element)
+            {
+                return testing::AssertionFailure() << "select(" << index << ") is " << s.select(index);
+            }
+
+            ++index;
+        }
+
+        return testing::AssertionSuccess();
+    }
+}
+
+
+TEST(SkipListSet_SanityCheckTests, canAddAndFindElements)
+{
+    SkipListSet<std::string> s;
+    ASSERT_TRUE(s.isImplemented());
+    ASSERT_EQ(0, s.size());
+    ASSERT_EQ(1, s.levelCount());
+    ASSERT_FALSE(s.contains("CAT"));
+
+    s.add("CAT");
+    s.add("DOG");
+    s.add("CAT");
+    s.add("ANT");
+
+    ASSERT_EQ(3, s.size());
+    ASSERT_TRUE(s.contains("ANT"));
+    ASSERT_TRUE(s.contains("CAT"));
+    ASSERT_TRUE(s.contains("DOG"));
+    ASSERT_FALSE(s.contains("BEE"));
+    ASSERT_FALSE(s.contains("EMU"));
+    ASSERT_EQ(3, s.elementsOnLevel(0));
+    ASSERT_TRUE(s.isElementOnLevel("DOG", 0));
+    ASSERT_FALSE(s.isElementOnLevel("BEE", 0));
+}
+
+
+TEST(SkipListSet_SanityCheckTests, elementsOccupyTheLevelsTheLevelTesterChooses)
+{
+    // Nothing is ever promoted, so there's the bottom level and the empty
+    // one above it.
+    SkipListSet<int> flat = makeSet(0.0);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        flat.add(i * 7 % 100);
+    }
+
+    ASSERT_EQ(2, flat.levelCount());
+    ASSERT_EQ(100, flat.elementsOnLevel(0));
+    ASSERT_EQ(0, flat.elementsOnLevel(1));
+    ASSERT_FALSE(flat.isElementOnLevel(50, 1));
+
+    // Everything is promoted as high as it can go.
+    SkipListSet<int> tall = makeSet(1.0, 3);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        tall.add(i * 7 % 100);
+    }
+
+    ASSERT_EQ(5, tall.levelCount());
+    ASSERT_EQ(100, tall.elementsOnLevel(3));
+    ASSERT_EQ(0, tall.elementsOnLevel(4));
+    ASSERT_EQ(0, tall.elementsOnLevel(5));
+    ASSERT_TRUE(tall.isElementOnLevel(50, 3));
+    ASSERT_FALSE(tall.isElementOnLevel(50, 4));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(flat.contains(i));
+        ASSERT_TRUE(tall.contains(i));
+    }
+}
+
+
+TEST(SkipListSet_SanityCheckTests, copiesAndMovesAreIndependent)
+{
+    SkipListSet<int> s1;
+
+    for (int i = 0; i < 50; ++i)
+    {
+        s1.add(i * 2);
+    }
+
+    SkipListSet<int> s2{s1};
+    s1.add(1);
+    s2.add(3);
+
+    ASSERT_EQ(51, s1.size());
+    ASSERT_EQ(51, s2.size());
+    ASSERT_TRUE(s1.contains(1));
+    ASSERT_FALSE(s1.contains(3));
+    ASSERT_TRUE(s2.contains(3));
+    ASSERT_FALSE(s2.contains(1));
+    ASSERT_EQ(s1.levelCount(), s2.levelCount());
+
+    SkipListSet<int> s3;
+    s3.add(1000);
+    s3 = s1;
+    ASSERT_EQ(51, s3.size());
+    ASSERT_FALSE(s3.contains(1000));
+    ASSERT_TRUE(s3.contains(1));
+
+    s3 = std::move(s2);
+    ASSERT_EQ(51, s3.size());
+    ASSERT_TRUE(s3.contains(3));
+    ASSERT_FALSE(s3.contains(1));
+}
+
+
+TEST(SkipListSet_SanityCheckTests, rankSelectAndEraseAtAgreeWithStdSetOnRandomOperations)
+{
+    std::mt19937 random{30};
+
+    for (double promotionProbability : {0.5, 0.25, 0.9})
+    {
+        SkipListSet<int, true> s = makeSet<true>(promotionProbability);
+        std::set<int> expected;
+
+        for (int step = 0; step < 3000; ++step)
+        {
+            int value = random() % 500;
+
+            if (random() % 3 != 0 || expected.empty())
+            {
+                s.add(value);
+                expected.insert(value);
+            }
+            else
+            {
+                unsigned int index = random() % expected.size();
+                s.eraseAt(index);
+                expected.erase(std::next(expected.begin(), index));
+            }
+
+            unsigned int rank = std::distance(expected.begin(), expected.lower_bound(value));
+            ASSERT_EQ(rank, s.rank(value));
+            ASSERT_EQ(expected.count(value) == 1, s.contains(value));
+
+            if (step % 100 == 0)
+            {
+                ASSERT_TRUE(matches(s, expected));
+                ASSERT_TRUE(matches(SkipListSet<int, true>{s}, expected));
+            }
+        }
+
+        ASSERT_TRUE(matches(s, expected));
+        ASSERT_THROW({ s.select(s.size()); }, std::out_of_range);
+        ASSERT_THROW({ s.eraseAt(s.size()); }, std::out_of_range);
+
+        // A set built by assignSorted() keeps its link widths right, too.
+        std::vector<int> sorted(expected.begin(), expected.end());
+        SkipListSet<int, true> appended = makeSet<true>(promotionProbability);
+        appended.assignSorted(sorted.begin(), sorted.end());
+
+        ASSERT_TRUE(matches(appended, expected));
+
+        while (appended.size() > 0)
+        {
+            unsigned int index = random() % appended.size();
+            appended.eraseAt(index);
+            expected.erase(std::next(expected.begin(), index));
+
+            ASSERT_TRUE(matches(appended, expected));
+        }
+
+        ASSERT_EQ(0, appended.rank(0));
+    }
+}
+
+
+TEST(SkipListSet_SanityCheckTests, movedFromSetCanBeUsedAgain)
+{
+    SkipListSet<std::string> s1;
+    s1.add("CAT");
+
+    SkipListSet<std::string> s2{std::move(s1)};
+    ASSERT_TRUE(s2.contains("CAT"));
+    ASSERT_EQ(0, s1.size());
+
+    // A moved-from set has given away its level tester, and needs a new
+    // one to add to it or copy it.
+    SkipListSet<std::string> s3{s1};
+    ASSERT_EQ(0, s3.size());
+
+    s1.add("DOG");
+    s3.add("EMU");
+    ASSERT_TRUE(s1.contains("DOG"));
+    ASSERT_FALSE(s1.contains("CAT"));
+    ASSERT_TRUE(s3.contains("EMU"));
+
+    SkipListSet<std::string, true> s4;
+    SkipListSet<std::string, true> s5{std::move(s4)};
+    std::string words[] = {"ANT", "BEE", "CAT"};
+    s4.assignSorted(std::begin(words), std::end(words));
+    ASSERT_EQ(3, s4.size());
+    ASSERT_EQ("BEE", s4.select(1));
+}
@@ -0,0 +1,63 @@
+// SortedWordList_SanityCheckTests.cpp
+
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "LevenshteinAutomaton.hpp"
+#include "RandomWords.hpp"
+#include "SortedWordList.hpp"
+
+
+TEST(SortedWordList_SanityCheckTests, nextMatchOrdersHighBytesAfterLowOnes)
+{
+    LevenshteinAutomaton automaton{"DA\xE9", 1};
+
+    ASSERT_EQ(std::string{"AA\xE9"}, automaton.nextMatch("A"));
+    ASSERT_TRUE(automaton.accepts("DA"));
+    ASSERT_FALSE(automaton.accepts("\xE9"));
+}
+
+
+TEST(SortedWordList_SanityCheckTests, findsWordsNearOneWithAHighByte)
+{
+    SortedWordList list{{"BDDC", "CAB"}, 1};
+
+    std::vector<std::pair<std::string, unsigned int>> found = list.findWithin("CAB\xE9", 1);
+
+    ASSERT_EQ(1, found.size());
+    ASSERT_EQ("CAB", found[0].first);
+    ASSERT_EQ(1, found[0].second);
+}
+
+
+TEST(SortedWordList_SanityCheckTests, findWithinAgreesWithEditDistanceOnRandomDictionaries)
+{
+    // Two of the letters are bytes above 0x7F, which are negative as a
+    // plain char, but sort after the others in a std::string.
+    const std::string letters{"ABCD\xC3\xE9"};
+    std::mt19937 random{40};
+
+    for (int trial = 0; trial < 40; ++trial)
+    {
+        std::vector<std::string> words = randomWords(random, letters, 4, 5 + trial * 3);
+        SortedWordList list{words};
+
+        for (int i = 0; i < 20; ++i)
+        {
+            std::string word = randomWord(random, letters, 4);
+
+            for (unsigned int distance : {0u, 1u, 2u})
+            {
+                ASSERT_EQ(wordsWithin(words, word, distance), list.findWithin(word, distance));
+            }
+        }
+
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        ASSERT_EQ(words.size(), list.size());
+    }
+}
@@ -0,0 +1,48 @@
+// SuggestionCache_SanityCheckTests.cpp
+
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "SkipListSet.hpp"
+#include "SuggestionCache.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    bool suggests(const std::vector<std::string>& suggestions, const std::string& word)
+    {
+        return std::find(suggestions.begin(), suggestions.end(), word) != suggestions.end();
+    }
+}
+
+
+TEST(SuggestionCache_SanityCheckTests, cachesSuggestionsUntilInvalidated)
+{
+    SkipListSet<std::string, true> words;
+    words.add("CAT");
+    words.add("DOG");
+
+    WordChecker generator{words};
+    SuggestionCache cache{generator, 100};
+
+    ASSERT_TRUE(suggests(cache.findSuggestions("CAR"), "CAT"));
+    ASSERT_TRUE(suggests(cache.findSuggestions("CAR"), "CAT"));
+    ASSERT_EQ(1, cache.stats().hits);
+
+    // Removing one word and adding another leaves the size the same, so
+    // only invalidate() can tell the cache the suggestions are stale.
+    words.eraseAt(words.rank("CAT"));
+    words.add("CAR");
+    cache.invalidate();
+
+    std::vector<std::string> suggestions = cache.findSuggestions("CAR");
+    ASSERT_FALSE(suggests(suggestions, "CAT"));
+
+    SuggestionCacheStats stats = cache.stats();
+    ASSERT_EQ(1, stats.hits);
+    ASSERT_EQ(2, stats.misses);
+    ASSERT_EQ(1, stats.invalidations);
+}
@@ -0,0 +1,87 @@
+// WordDawg_SanityCheckTests.cpp
+
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "RandomWords.hpp"
+#include "WordDawg.hpp"
+
+
+TEST(WordDawg_SanityCheckTests, containsExactlyTheDistinctWords)
+{
+    WordDawg dawg{{"CATS", "RATS", "CATS", ""}};
+
+    ASSERT_EQ(3, dawg.size());
+    ASSERT_TRUE(dawg.contains("CATS"));
+    ASSERT_TRUE(dawg.contains("RATS"));
+    ASSERT_TRUE(dawg.contains(""));
+    ASSERT_FALSE(dawg.contains("CAT"));
+    ASSERT_FALSE(dawg.contains("CATSS"));
+
+    // The "ATS" shared by CATS and RATS is stored only once, so there's
+    // a node for the start, one for after C or R, and one after each of
+    // A, T and S.
+    ASSERT_EQ(5, dawg.nodeCount());
+}
+
+
+TEST(WordDawg_SanityCheckTests, findSuggestionsAgreesWithEditDistanceOnRandomDictionaries)
+{
+    std::mt19937 random{34};
+
+    for (int trial = 0; trial < 30; ++trial)
+    {
+        std::vector<std::string> words = randomWords(random, "ABCD", 6, 5 + trial * 4);
+        WordDawg dawg{words};
+
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        ASSERT_EQ(words.size(), dawg.size());
+
+        for (int i = 0; i < 20; ++i)
+        {
+            std::string word = randomWord(random, "ABCDE", 7);
+
+            // Every edit, which uses only letters, makes a word at edit
+            // distance 1, except that replacing a character with itself
+            // makes the word, and swapping two different adjacent
+            // characters makes one at distance 2.
+            std::vector<std::string> expected;
+
+            for (const auto& [w, distance] : wordsWithin(words, word, 2))
+            {
+                bool swapped = false;
+
+                for (std::size_t j = 0; j + 1 < word.size(); ++j)
+                {
+                    std::string s = word;
+                    std::swap(s[j], s[j + 1]);
+                    swapped = swapped || s == w;
+                }
+
+                if (distance == 1 || (distance == 0 && !word.empty()) || swapped)
+                {
+                    expected.push_back(w);
+                }
+            }
+
+            // The splits come last, in order; the edits come first, in
+            // any order, with no duplicates.
+            std::vector<std::string> splits = splitsWithin(words, word);
+            std::vector<std::string> suggestions = dawg.findSuggestions(word);
+
+            ASSERT_EQ(expected.size() + splits.size(), suggestions.size());
+            ASSERT_TRUE(std::equal(splits.begin(), splits.end(), suggestions.end() - splits.size()));
+
+            std::vector<std::string> edits(suggestions.begin(), suggestions.end() - splits.size());
+            std::sort(expected.begin(), expected.end());
+            std::sort(edits.begin(), edits.end());
+
+            ASSERT_EQ(expected, edits);
+        }
+    }
+}
@@ -0,0 +1,11 @@
+// gtestmain.cpp
+
+#include <gtest/gtest.h>
+
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
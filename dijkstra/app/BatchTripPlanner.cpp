@@ -0,0 +1,169 @@
+// BatchTripPlanner.cpp
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <map>
+#include <thread>
+#include <utility>
+#include "BatchTripPlanner.hpp"
+#include "DigraphException.hpp"
+#include "TripMetricWeights.hpp"
+
+
+namespace
+{
+    // A TripGroup is the trips that share a start vertex and a metric,
+    // listed by their positions in the batch.
+    struct TripGroup
+    {
+        int startVertex;
+        TripMetric metric;
+        std::vector<std::size_t> trips;
+    };
+}
+
+
+double BatchTripReport::tripsPerSecond() const noexcept
+{
+    return seconds > 0.0 ? trips / seconds : 0.0;
+}
+
+
+BatchTripPlanner::BatchTripPlanner(const FrozenDigraph& frozenMap, unsigned int threadCount)
+    : frozenMap{frozenMap},
+      threadCount{threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())}
+{
+    // A missing column would otherwise only be noticed on one of the
+    // threads, where the exception couldn't be caught.
+    for (TripMetric metric : {TripMetric::Distance, TripMetric::Time})
+    {
+        if (tripMetricColumn(metric) >= frozenMap.columnCount())
+        {
+            throw DigraphException{"Frozen road map has no weight column for a trip metric"};
+        }
+    }
+}
+
+
+BatchTripReport BatchTripPlanner::findTrips(
+    const std::vector<Trip>& trips, std::vector<ShortestPath>& paths) const
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // Every vertex is checked up front, so that an exception is thrown
+    // here, rather than on one of the threads.
+    for (const Trip& trip : trips)
+    {
+        frozenMap.indexOf(trip.startVertex);
+        frozenMap.indexOf(trip.endVertex);
+    }
+
+    std::map<std::pair<int, TripMetric>, std::size_t> groupPositions;
+    std::vector<TripGroup> groups;
+
+    for (std::size_t i = 0; i < trips.size(); ++i)
+    {
+        auto [position, added] = groupPositions.emplace(
+            std::make_pair(trips[i].startVertex, trips[i].metric), groups.size());
+
+        if (added)
+        {
+            groups.push_back(TripGroup{trips[i].startVertex, trips[i].metric, {}});
+        }
+
+        groups[position->second].trips.push_back(i);
+    }
+
+    std::stable_sort(
+        groups.begin(), groups.end(),
+        [](const TripGroup& a, const TripGroup& b)
+        {
+            return a.trips.size() > b.trips.size();
+        });
+
+    paths.assign(trips.size(), ShortestPath{});
+
+    // Each thread takes the next group not yet taken.  Every trip belongs
+    // to exactly one group, so each element of "paths" is written by only
+    // one thread.
+    std::atomic<std::size_t> nextGroup{0};
+
+    // An exception thrown on any thread (by a failed allocation, say) is
+    // caught there, and leaves no more groups for any thread to take; the
+    // first one is thrown again once every thread has finished.
+    unsigned int threadsNeeded = std::min<std::size_t>(threadCount, groups.size());
+    std::vector<std::exception_ptr> failures(threadsNeeded);
+
+    auto work =
+        [&](unsigned int t)
+        {
+            try
+            {
+                std::vector<int> endVertices;
+
+                for (std::size_t g = nextGroup++; g < groups.size(); g = nextGroup++)
+                {
+                    const TripGroup& group = groups[g];
+
+                    endVertices.clear();
+
+                    for (std::size_t trip : group.trips)
+                    {
+                        endVertices.push_back(trips[trip].endVertex);
+                    }
+
+                    std::vector<ShortestPath> found = frozenMap.findShortestPathsTo(
+                        group.startVertex, endVertices, tripMetricColumn(group.metric));
+
+                    for (std::size_t i = 0; i < group.trips.size(); ++i)
+                    {
+                        paths[group.trips[i]] = std::move(found[i]);
+                    }
+                }
+            }
+            catch (...)
+            {
+                failures[t] = std::current_exception();
+                nextGroup = groups.size();
+            }
+        };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadsNeeded);
+
+    for (unsigned int t = 1; t < threadsNeeded; ++t)
+    {
+        threads.emplace_back(work, t);
+    }
+
+    // The calling thread does its share of the work, too.
+    if (threadsNeeded > 0)
+    {
+        work(0);
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (std::exception_ptr& failure : failures)
+    {
+        if (failure)
+        {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    BatchTripReport report;
+    report.trips = trips.size();
+    report.groups = groups.size();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    report.seconds = elapsed.count();
+
+    return report;
+}
+
@@ -0,0 +1,65 @@
+// BatchTripPlanner.hpp
+//
+// A BatchTripPlanner finds the shortest paths for a whole batch of trips
+// at once, rather than one trip at a time.
+//
+// Trips that share a start vertex and a TripMetric are grouped together,
+// and each group is found with a single search from the shared start
+// vertex, which stops as soon as every one of the group's end vertices
+// has been reached.  The groups are spread across a pool of threads, all
+// searching the same (read-only) frozen road map, with the largest groups
+// taken first so that no thread is left with a big one at the end.  The
+// paths come back in the same order as the trips.
+
+#ifndef BATCHTRIPPLANNER_HPP
+#define BATCHTRIPPLANNER_HPP
+
+#include <cstddef>
+#include <vector>
+#include "FrozenDigraph.hpp"
+#include "ShortestPath.hpp"
+#include "Trip.hpp"
+
+
+
+struct BatchTripReport
+{
+    std::size_t trips = 0;
+    std::size_t groups = 0;
+    double seconds = 0.0;
+
+    double tripsPerSecond() const noexcept;
+};
+
+
+
+class BatchTripPlanner
+{
+public:
+    // Builds a BatchTripPlanner that finds trips on the given frozen road
+    // map, which must have been built by freezeRoadMap(), using the given
+    // number of threads (or one per core, if it's zero).  A
+    // DigraphException is thrown if the map is missing the weight column
+    // for any TripMetric.
+    explicit BatchTripPlanner(const FrozenDigraph& frozenMap, unsigned int threadCount = 0);
+
+
+    // findTrips() stores the shortest path for each of the given trips in
+    // the corresponding element of "paths", which is resized to match,
+    // and returns a summary of what was done.  A DigraphException is
+    // thrown, before any searching is done, if any of the trips starts or
+    // ends at a vertex that doesn't exist.  Any other exception thrown by
+    // a search on any thread is thrown again here once every thread has
+    // stopped, in which case the contents of "paths" are unspecified.
+    BatchTripReport findTrips(const std::vector<Trip>& trips, std::vector<ShortestPath>& paths) const;
+
+
+private:
+    const FrozenDigraph& frozenMap;
+    unsigned int threadCount;
+};
+
+
+
+#endif
+
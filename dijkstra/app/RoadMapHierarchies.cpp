@@ -0,0 +1,31 @@
+// RoadMapHierarchies.cpp
+
+#include "RoadMapHierarchies.hpp"
+#include "TripMetricWeights.hpp"
+
+
+RoadMapHierarchies::RoadMapHierarchies(const RoadMap& roadMap)
+    : frozen{freezeRoadMap(roadMap)},
+      distanceHierarchy{frozen, tripMetricColumn(TripMetric::Distance)},
+      timeHierarchy{frozen, tripMetricColumn(TripMetric::Time)}
+{
+}
+
+
+const FrozenDigraph& RoadMapHierarchies::frozenMap() const noexcept
+{
+    return frozen;
+}
+
+
+const ContractionHierarchy& RoadMapHierarchies::hierarchy(TripMetric metric) const noexcept
+{
+    return metric == TripMetric::Distance ? distanceHierarchy : timeHierarchy;
+}
+
+
+ShortestPath RoadMapHierarchies::findShortestPath(const Trip& trip) const
+{
+    return hierarchy(trip.metric).findShortestPath(trip.startVertex, trip.endVertex);
+}
+
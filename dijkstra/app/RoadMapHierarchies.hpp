@@ -0,0 +1,55 @@
+// RoadMapHierarchies.hpp
+//
+// A RoadMapHierarchies holds a frozen copy of a RoadMap along with one
+// ContractionHierarchy for each TripMetric, so that, once they've been
+// built, any number of trips can be found quickly.  It's worth building
+// only when there are many trips to find on a road map that doesn't
+// change; building it takes far longer than finding one trip does.
+
+#ifndef ROADMAPHIERARCHIES_HPP
+#define ROADMAPHIERARCHIES_HPP
+
+#include "ContractionHierarchy.hpp"
+#include "FrozenDigraph.hpp"
+#include "RoadMap.hpp"
+#include "ShortestPath.hpp"
+#include "Trip.hpp"
+#include "TripMetric.hpp"
+
+
+
+class RoadMapHierarchies
+{
+public:
+    // Builds the hierarchies for the given RoadMap.
+    explicit RoadMapHierarchies(const RoadMap& roadMap);
+
+    // The hierarchies refer to the frozen road map, so they can't simply
+    // be copied along with it.
+    RoadMapHierarchies(const RoadMapHierarchies&) = delete;
+    RoadMapHierarchies& operator=(const RoadMapHierarchies&) = delete;
+
+
+    // frozenMap() returns the frozen road map that the hierarchies were
+    // built from.
+    const FrozenDigraph& frozenMap() const noexcept;
+
+
+    // hierarchy() returns the hierarchy for the given TripMetric.
+    const ContractionHierarchy& hierarchy(TripMetric metric) const noexcept;
+
+
+    // findShortestPath() returns the shortest path for the given Trip.
+    ShortestPath findShortestPath(const Trip& trip) const;
+
+
+private:
+    FrozenDigraph frozen;
+    ContractionHierarchy distanceHierarchy;
+    ContractionHierarchy timeHierarchy;
+};
+
+
+
+#endif
+
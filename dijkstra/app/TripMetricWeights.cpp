@@ -0,0 +1,29 @@
+// TripMetricWeights.cpp
+
+#include "TripMetricWeights.hpp"
+
+
+std::function<double(const RoadSegment&)> tripMetricWeight(TripMetric metric)
+{
+    if (metric == TripMetric::Distance)
+    {
+        return DistanceWeight{};
+    }
+    else
+    {
+        return TimeWeight{};
+    }
+}
+
+
+unsigned int tripMetricColumn(TripMetric metric) noexcept
+{
+    return metric == TripMetric::Distance ? 0 : 1;
+}
+
+
+FrozenDigraph freezeRoadMap(const RoadMap& roadMap)
+{
+    // The columns must be in the order given by tripMetricColumn().
+    return roadMap.freeze(DistanceWeight{}, TimeWeight{});
+}
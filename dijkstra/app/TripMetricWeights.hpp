@@ -0,0 +1,57 @@
+// TripMetricWeights.hpp
+//
+// Functions that connect TripMetrics to the weights of the edges in a
+// RoadMap: a trip that minimizes distance weighs each RoadSegment by its
+// length in miles, while a trip that minimizes driving time weighs it by
+// the time (in hours) it takes to drive.
+
+#ifndef TRIPMETRICWEIGHTS_HPP
+#define TRIPMETRICWEIGHTS_HPP
+
+#include <functional>
+#include "FrozenDigraph.hpp"
+#include "RoadMap.hpp"
+#include "RoadSegment.hpp"
+#include "TripMetric.hpp"
+
+
+
+// DistanceWeight and TimeWeight are the function objects that weigh a
+// RoadSegment for each TripMetric.  Being ordinary types, rather than
+// std::functions, they can be inlined wherever they're called.
+
+struct DistanceWeight
+{
+    double operator()(const RoadSegment& segment) const noexcept
+    {
+        return segment.miles;
+    }
+};
+
+
+struct TimeWeight
+{
+    double operator()(const RoadSegment& segment) const noexcept
+    {
+        return segment.miles / segment.milesPerHour;
+    }
+};
+
+
+// tripMetricWeight() returns the function that gives the weight of a
+// RoadSegment when measuring trips by the given TripMetric.
+std::function<double(const RoadSegment&)> tripMetricWeight(TripMetric metric);
+
+
+// tripMetricColumn() returns the position of the weight column for the
+// given TripMetric in a FrozenDigraph built by freezeRoadMap().
+unsigned int tripMetricColumn(TripMetric metric) noexcept;
+
+
+// freezeRoadMap() returns a FrozenDigraph of the given RoadMap, with one
+// weight column for each TripMetric.
+FrozenDigraph freezeRoadMap(const RoadMap& roadMap);
+
+
+
+#endif
@@ -0,0 +1,83 @@
+// TripWriter.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <iomanip>
+#include "TripWriter.hpp"
+
+
+namespace
+{
+    // writeTime() writes a number of hours as hours, minutes, and seconds,
+    // such as "1 hrs 4 mins 32.7 secs".
+    void writeTime(std::ostream& out, double hours)
+    {
+        double seconds = hours * 3600.0;
+        int wholeHours = static_cast<int>(seconds / 3600.0);
+        seconds -= wholeHours * 3600.0;
+        int wholeMinutes = static_cast<int>(seconds / 60.0);
+        seconds -= wholeMinutes * 60.0;
+
+        if (wholeHours > 0)
+        {
+            out << wholeHours << " hrs ";
+        }
+
+        out << wholeMinutes << " mins " << seconds << " secs";
+    }
+}
+
+
+void TripWriter::writeTrip(
+    std::ostream& out, const RoadMap& roadMap,
+    const Trip& trip, const ShortestPath& path)
+{
+    bool byDistance = trip.metric == TripMetric::Distance;
+
+    out << std::fixed << std::setprecision(1);
+    out << (byDistance ? "Shortest distance" : "Shortest driving time")
+        << " from " << roadMap.vertexInfo(trip.startVertex)
+        << " to " << roadMap.vertexInfo(trip.endVertex) << std::endl;
+
+    if (path.vertices.empty())
+    {
+        out << "  No route exists" << std::endl;
+        return;
+    }
+
+    out << "  Begin at " << roadMap.vertexInfo(path.vertices.front()) << std::endl;
+
+    for (std::size_t i = 0; i < path.segmentWeights.size(); ++i)
+    {
+        int fromVertex = path.vertices[i];
+        int toVertex = path.vertices[i + 1];
+
+        out << "  Continue to " << roadMap.vertexInfo(toVertex) << " (";
+
+        if (byDistance)
+        {
+            out << path.segmentWeights[i] << " miles";
+        }
+        else
+        {
+            RoadSegment segment = roadMap.edgeInfo(fromVertex, toVertex);
+            out << segment.miles << " miles @ " << segment.milesPerHour << "mph = ";
+            writeTime(out, path.segmentWeights[i]);
+        }
+
+        out << ")" << std::endl;
+    }
+
+    if (byDistance)
+    {
+        out << "Total distance: " << path.totalWeight << " miles" << std::endl;
+    }
+    else
+    {
+        out << "Total time: ";
+        writeTime(out, path.totalWeight);
+        out << std::endl;
+    }
+}
+
@@ -0,0 +1,35 @@
+// TripWriter.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// The TripWriter class writes the route found for a Trip to an output
+// stream, one road segment per line, in the format described in the
+// project write-up.
+
+#ifndef TRIPWRITER_HPP
+#define TRIPWRITER_HPP
+
+#include <ostream>
+#include "RoadMap.hpp"
+#include "ShortestPath.hpp"
+#include "Trip.hpp"
+
+
+
+class TripWriter
+{
+public:
+    // writeTrip() writes the given path, which must have been found for
+    // the given Trip on the given RoadMap, to the given output stream.
+    // Distances are written in miles; driving times are written in hours,
+    // minutes, and seconds, leaving out hours when there are none.
+    void writeTrip(
+        std::ostream& out, const RoadMap& roadMap,
+        const Trip& trip, const ShortestPath& path);
+};
+
+
+
+#endif
+
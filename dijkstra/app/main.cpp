@@ -6,10 +6,35 @@
 // This is the program's main() function, which is the entry point for your
 // console user interface.
 
+#include <iostream>
+#include "BatchTripPlanner.hpp"
+#include "InputReader.hpp"
+#include "RoadMapReader.hpp"
+#include "TripMetricWeights.hpp"
+#include "TripReader.hpp"
+#include "TripWriter.hpp"
+
 
 int main()
 {
+    InputReader in{std::cin};
+    RoadMap roadMap = RoadMapReader{}.readRoadMap(in);
+    std::vector<Trip> trips = TripReader{}.readTrips(in);
+
+    // The road map doesn't change while the trips are found, so it's
+    // frozen once, with a weight column for each TripMetric, and the
+    // trips are all found together, sharing searches where they can.
+    FrozenDigraph frozenMap = freezeRoadMap(roadMap);
+    std::vector<ShortestPath> paths;
+    BatchTripPlanner{frozenMap}.findTrips(trips, paths);
+
+    TripWriter writer;
 
+    for (std::size_t i = 0; i < trips.size(); ++i)
+    {
+        writer.writeTrip(std::cout, roadMap, trips[i], paths[i]);
+        std::cout << std::endl;
+    }
 
     return 0;
 }
@@ -0,0 +1,741 @@
+// ContractionHierarchy.hpp
+//
+// A ContractionHierarchy answers point-to-point shortest path queries on
+// a FrozenDigraph, using one of its weight columns, much faster than a
+// search of the graph itself can, by doing most of the work ahead of time.
+//
+// Ahead of time, the vertices are "contracted" one at a time, least
+// important first.  Contracting a vertex v removes it from the graph,
+// and for each pair of neighbors u and w such that the only shortest path
+// from u to w went through v, adds a "shortcut" edge from u to w with the
+// same length as that path.  Whether a shortcut is needed is decided by a
+// "witness search", a small search from u that avoids v; if it finds
+// another path to w that's no longer, the shortcut isn't needed.  The
+// order in which vertices are contracted is chosen greedily by "edge
+// difference", the number of shortcuts contracting a vertex would add
+// less the number of edges it would remove, along with the number of its
+// neighbors already contracted, which keeps the contractions spread out.
+//
+// Each vertex's rank is its position in that order.  A query searches
+// forward from the start vertex and backward from the end vertex, as a
+// bidirectional Dijkstra search does, except that both searches only
+// follow edges (original or shortcut) toward higher-ranked vertices;
+// every shortest path can be found that way, since the hierarchy
+// preserves distances.  On a road map, that means the searches quickly
+// climb to the few important vertices (e.g., highway intersections) and
+// settle only a few hundred vertices altogether, no matter how far apart
+// the start and end are.  Any shortcuts along the path that's found are
+// then "unpacked" back into the edges they stand for.
+//
+// A ContractionHierarchy refers to the FrozenDigraph it was built from,
+// which must outlive it.  Queries can be run from many threads at once.
+
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "DigraphException.hpp"
+#include "FrozenDigraph.hpp"
+#include "ShortestPath.hpp"
+
+
+
+// A ContractionSearchStats describes the work done by one query.
+
+struct ContractionSearchStats
+{
+    unsigned int settledVertices;
+    unsigned int stalledVertices;
+};
+
+
+
+class ContractionHierarchy
+{
+public:
+    // Builds a ContractionHierarchy for the given FrozenDigraph, using the
+    // weights in the given column.
+    ContractionHierarchy(const FrozenDigraph& graph, unsigned int column);
+
+
+    // column() returns the weight column that this hierarchy was built
+    // from.
+    unsigned int column() const noexcept;
+
+
+    // rank() returns the position in the contraction order of the vertex
+    // with the given index, from 0 (the first contracted) to V - 1.
+    unsigned int rank(unsigned int index) const noexcept;
+
+
+    // shortcutCount() returns the number of shortcuts in the hierarchy.
+    unsigned int shortcutCount() const noexcept;
+
+
+    // memoryUsage() returns the number of bytes taken by the hierarchy's
+    // ranks and edges, not counting the FrozenDigraph it refers to.
+    std::size_t memoryUsage() const noexcept;
+
+
+    // findShortestPath() is like FrozenDigraph::findShortestPath(), but
+    // searches the hierarchy instead of the graph.  If stats is not null,
+    // the work done is stored there.  A DigraphException is thrown if
+    // either vertex does not exist.
+    ShortestPath findShortestPath(
+        int startVertex, int endVertex, ContractionSearchStats* stats = nullptr) const;
+
+
+private:
+    static constexpr unsigned int NO_MIDDLE = std::numeric_limits<unsigned int>::max();
+
+    // An Arc is an edge of the hierarchy, seen from one of its ends:
+    // "vertex" is the index of the other end, and "middle" is the index
+    // of the vertex whose contraction created it if it's a shortcut, or
+    // NO_MIDDLE if it's one of the graph's own edges.
+    struct Arc
+    {
+        unsigned int vertex;
+        double weight;
+        unsigned int middle;
+    };
+
+    struct Contraction;
+    struct Search;
+
+    const FrozenDigraph& graph;
+    unsigned int weightColumn;
+    std::vector<unsigned int> ranks;
+    unsigned int shortcuts;
+
+    // The upward arcs of the vertex with index v, which leave it toward
+    // higher-ranked vertices, are upArcs[upOffsets[v]] up to (but not
+    // including) upArcs[upOffsets[v + 1]].  Its downward arcs, which
+    // enter it from higher-ranked vertices and are what the backward
+    // search follows, are stored the same way.
+    std::vector<unsigned int> upOffsets;
+    std::vector<Arc> upArcs;
+    std::vector<unsigned int> downOffsets;
+    std::vector<Arc> downArcs;
+
+    // unpack() appends the edges that the arc from the vertex with index
+    // "from" to the one with index "to" stands for to the given path.
+    void unpack(
+        unsigned int from, unsigned int to, double weight, unsigned int middle,
+        ShortestPath& path) const;
+
+    // findArc() returns the arc among the given ones that leads to (or
+    // comes from) the vertex with the given index.
+    static const Arc& findArc(
+        const std::vector<Arc>& arcs, unsigned int first, unsigned int last, unsigned int vertex);
+};
+
+
+
+// A Contraction holds the graph that remains while vertices are being
+// contracted, along with what's needed for witness searches on it.
+
+struct ContractionHierarchy::Contraction
+{
+    // A witness search gives up after settling this many vertices, adding
+    // a shortcut that may not have been needed rather than searching on.
+    static constexpr unsigned int WITNESS_SETTLE_LIMIT = 500;
+
+    std::vector<std::vector<Arc>> outArcs;
+    std::vector<std::vector<Arc>> inArcs;
+    std::vector<unsigned int> contractedNeighbors;
+
+    std::vector<double> witnessDistances;
+    std::vector<unsigned int> witnessTouched;
+    std::vector<bool> witnessTargets;
+    std::vector<std::pair<double, unsigned int>> witnessQueue;
+
+    Contraction(const FrozenDigraph& graph, unsigned int column);
+
+    // addArc() adds an arc to the remaining graph, unless it already has
+    // one from and to the same vertices that's no longer.
+    void addArc(unsigned int from, unsigned int to, double weight, unsigned int middle);
+
+    // witnessSearch() finds the distances from the given source to other
+    // remaining vertices, avoiding the vertex being contracted, up to the
+    // given limit, stopping early once the given number of vertices marked
+    // in witnessTargets have been settled; clearWitnessSearch() resets the
+    // distances afterward.
+    void witnessSearch(unsigned int source, unsigned int avoid, double limit, unsigned int targetCount);
+    void clearWitnessSearch();
+
+    // contract() returns the number of shortcuts that contracting the
+    // given vertex needs.  Unless "simulate" is true, it also adds them
+    // and removes the vertex from the remaining graph.
+    unsigned int contract(unsigned int v, bool simulate);
+
+    // priority() returns the given vertex's priority for contraction,
+    // lowest first.
+    int priority(unsigned int v);
+};
+
+
+
+// A Search holds the distances and parents for one query.  Since a query
+// touches only a small fraction of the vertices, the arrays are kept from
+// one query to the next (one set per thread), and only the entries that
+// were touched are reset afterward.
+
+struct ContractionHierarchy::Search
+{
+    std::vector<double> distances[2];
+    std::vector<unsigned int> parents[2];
+    std::vector<const Arc*> parentArcs[2];
+    std::vector<unsigned int> touched;
+
+    void prepare(unsigned int vertexCount);
+    void reset();
+};
+
+
+
+inline ContractionHierarchy::Contraction::Contraction(const FrozenDigraph& graph, unsigned int column)
+    : outArcs(graph.vertexCount()), inArcs(graph.vertexCount()),
+      contractedNeighbors(graph.vertexCount(), 0),
+      witnessDistances(graph.vertexCount(), std::numeric_limits<double>::infinity()),
+      witnessTargets(graph.vertexCount(), false)
+{
+    const std::vector<double>& weight = graph.weights(column);
+
+    for (unsigned int v = 0; v < graph.vertexCount(); ++v)
+    {
+        for (unsigned int e = graph.firstEdge(v); e < graph.lastEdge(v); ++e)
+        {
+            // Loops never lie on shortest paths, so they're left out.
+            if (graph.target(e) != v)
+            {
+                addArc(v, graph.target(e), weight[e], NO_MIDDLE);
+            }
+        }
+    }
+}
+
+
+inline void ContractionHierarchy::Contraction::addArc(
+    unsigned int from, unsigned int to, double weight, unsigned int middle)
+{
+    for (Arc& out : outArcs[from])
+    {
+        if (out.vertex == to)
+        {
+            if (weight < out.weight)
+            {
+                out = Arc{to, weight, middle};
+
+                for (Arc& in : inArcs[to])
+                {
+                    if (in.vertex == from)
+                    {
+                        in = Arc{from, weight, middle};
+                    }
+                }
+            }
+
+            return;
+        }
+    }
+
+    outArcs[from].push_back(Arc{to, weight, middle});
+    inArcs[to].push_back(Arc{from, weight, middle});
+}
+
+
+inline void ContractionHierarchy::Contraction::witnessSearch(
+    unsigned int source, unsigned int avoid, double limit, unsigned int targetCount)
+{
+    // The queue is a heap kept in a member vector, rather than a
+    // std::priority_queue, so that its storage is reused from one witness
+    // search to the next; there are a great many of them.
+    auto later = std::greater<std::pair<double, unsigned int>>{};
+
+    witnessDistances[source] = 0.0;
+    witnessTouched.push_back(source);
+    witnessQueue.clear();
+    witnessQueue.emplace_back(0.0, source);
+
+    unsigned int settled = 0;
+
+    while (!witnessQueue.empty() && settled < WITNESS_SETTLE_LIMIT && targetCount > 0)
+    {
+        std::pop_heap(witnessQueue.begin(), witnessQueue.end(), later);
+        auto [distance, v] = witnessQueue.back();
+        witnessQueue.pop_back();
+
+        if (distance > witnessDistances[v])
+        {
+            continue;
+        }
+
+        if (distance > limit)
+        {
+            break;
+        }
+
+        ++settled;
+
+        if (witnessTargets[v])
+        {
+            --targetCount;
+        }
+
+        for (const Arc& out : outArcs[v])
+        {
+            double throughV = distance + out.weight;
+
+            if (out.vertex != avoid && throughV < witnessDistances[out.vertex])
+            {
+                if (witnessDistances[out.vertex] == std::numeric_limits<double>::infinity())
+                {
+                    witnessTouched.push_back(out.vertex);
+                }
+
+                witnessDistances[out.vertex] = throughV;
+                witnessQueue.emplace_back(throughV, out.vertex);
+                std::push_heap(witnessQueue.begin(), witnessQueue.end(), later);
+            }
+        }
+    }
+}
+
+
+inline void ContractionHierarchy::Contraction::clearWitnessSearch()
+{
+    for (unsigned int v : witnessTouched)
+    {
+        witnessDistances[v] = std::numeric_limits<double>::infinity();
+    }
+
+    witnessTouched.clear();
+}
+
+
+inline unsigned int ContractionHierarchy::Contraction::contract(unsigned int v, bool simulate)
+{
+    struct Shortcut
+    {
+        unsigned int from;
+        unsigned int to;
+        double weight;
+    };
+
+    std::vector<Shortcut> needed;
+
+    for (const Arc& out : outArcs[v])
+    {
+        witnessTargets[out.vertex] = true;
+    }
+
+    for (const Arc& in : inArcs[v])
+    {
+        double longestOut = 0.0;
+        unsigned int targetCount = 0;
+
+        for (const Arc& out : outArcs[v])
+        {
+            if (out.vertex != in.vertex)
+            {
+                longestOut = std::max(longestOut, out.weight);
+                ++targetCount;
+            }
+        }
+
+        // The search from in.vertex settles in.vertex itself first, which
+        // counts as a target if it's also one of v's out-neighbors.
+        witnessSearch(in.vertex, v, in.weight + longestOut, targetCount + witnessTargets[in.vertex]);
+
+        for (const Arc& out : outArcs[v])
+        {
+            double via = in.weight + out.weight;
+
+            if (out.vertex != in.vertex && witnessDistances[out.vertex] > via)
+            {
+                needed.push_back(Shortcut{in.vertex, out.vertex, via});
+            }
+        }
+
+        clearWitnessSearch();
+    }
+
+    for (const Arc& out : outArcs[v])
+    {
+        witnessTargets[out.vertex] = false;
+    }
+
+    if (!simulate)
+    {
+        for (const Shortcut& shortcut : needed)
+        {
+            addArc(shortcut.from, shortcut.to, shortcut.weight, v);
+        }
+
+        // The vertex is removed from its neighbors' lists, so that later
+        // witness searches never see it.
+        for (const Arc& in : inArcs[v])
+        {
+            std::vector<Arc>& arcs = outArcs[in.vertex];
+            arcs.erase(std::find_if(arcs.begin(), arcs.end(), [v](const Arc& a) { return a.vertex == v; }));
+            ++contractedNeighbors[in.vertex];
+        }
+
+        for (const Arc& out : outArcs[v])
+        {
+            std::vector<Arc>& arcs = inArcs[out.vertex];
+            arcs.erase(std::find_if(arcs.begin(), arcs.end(), [v](const Arc& a) { return a.vertex == v; }));
+            ++contractedNeighbors[out.vertex];
+        }
+
+        outArcs[v].clear();
+        inArcs[v].clear();
+    }
+
+    return needed.size();
+}
+
+
+inline int ContractionHierarchy::Contraction::priority(unsigned int v)
+{
+    int edgeDifference =
+        static_cast<int>(contract(v, true))
+        - static_cast<int>(inArcs[v].size() + outArcs[v].size());
+
+    // Weighing the edge difference double was found to give both fewer
+    // shortcuts and faster contraction on grid-like road maps.
+    return 2 * edgeDifference + static_cast<int>(contractedNeighbors[v]);
+}
+
+
+inline void ContractionHierarchy::Search::prepare(unsigned int vertexCount)
+{
+    if (distances[0].size() < vertexCount)
+    {
+        for (int side = 0; side < 2; ++side)
+        {
+            distances[side].resize(vertexCount, std::numeric_limits<double>::infinity());
+            parents[side].resize(vertexCount);
+            parentArcs[side].resize(vertexCount);
+        }
+    }
+}
+
+
+inline void ContractionHierarchy::Search::reset()
+{
+    for (unsigned int v : touched)
+    {
+        distances[0][v] = std::numeric_limits<double>::infinity();
+        distances[1][v] = std::numeric_limits<double>::infinity();
+    }
+
+    touched.clear();
+}
+
+
+inline ContractionHierarchy::ContractionHierarchy(const FrozenDigraph& graph, unsigned int column)
+    : graph{graph}, weightColumn{column}, ranks(graph.vertexCount()), shortcuts{0}
+{
+    unsigned int vertexCount = graph.vertexCount();
+    Contraction contraction{graph, column};
+
+    // Each vertex's arcs are recorded as it's contracted, since it's only
+    // then that they're known to be final.
+    std::vector<std::vector<Arc>> up(vertexCount);
+    std::vector<std::vector<Arc>> down(vertexCount);
+
+    // Priorities change as neighbors are contracted, but rather than
+    // updating them then, each vertex's priority is recomputed when it
+    // reaches the front of the queue; if it's no longer the lowest, the
+    // vertex goes back in.
+    using Entry = std::pair<int, unsigned int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+
+    for (unsigned int v = 0; v < vertexCount; ++v)
+    {
+        pq.emplace(contraction.priority(v), v);
+    }
+
+    unsigned int nextRank = 0;
+
+    while (!pq.empty())
+    {
+        unsigned int v = pq.top().second;
+        pq.pop();
+
+        int current = contraction.priority(v);
+
+        if (!pq.empty() && current > pq.top().first)
+        {
+            pq.emplace(current, v);
+            continue;
+        }
+
+        up[v] = contraction.outArcs[v];
+        down[v] = contraction.inArcs[v];
+        contraction.contract(v, false);
+        ranks[v] = nextRank++;
+    }
+
+    upOffsets.reserve(vertexCount + 1);
+    downOffsets.reserve(vertexCount + 1);
+
+    for (unsigned int v = 0; v < vertexCount; ++v)
+    {
+        upOffsets.push_back(upArcs.size());
+        downOffsets.push_back(downArcs.size());
+
+        for (const Arc& arc : up[v])
+        {
+            upArcs.push_back(arc);
+            shortcuts += arc.middle != NO_MIDDLE;
+        }
+
+        for (const Arc& arc : down[v])
+        {
+            downArcs.push_back(arc);
+            shortcuts += arc.middle != NO_MIDDLE;
+        }
+    }
+
+    upOffsets.push_back(upArcs.size());
+    downOffsets.push_back(downArcs.size());
+}
+
+
+inline unsigned int ContractionHierarchy::column() const noexcept
+{
+    return weightColumn;
+}
+
+
+inline unsigned int ContractionHierarchy::rank(unsigned int index) const noexcept
+{
+    return ranks[index];
+}
+
+
+inline unsigned int ContractionHierarchy::shortcutCount() const noexcept
+{
+    return shortcuts;
+}
+
+
+inline std::size_t ContractionHierarchy::memoryUsage() const noexcept
+{
+    return ranks.size() * sizeof(unsigned int)
+        + (upOffsets.size() + downOffsets.size()) * sizeof(unsigned int)
+        + (upArcs.size() + downArcs.size()) * sizeof(Arc);
+}
+
+
+inline ShortestPath ContractionHierarchy::findShortestPath(
+    int startVertex, int endVertex, ContractionSearchStats* stats) const
+{
+    unsigned int startIndex = graph.indexOf(startVertex);
+    unsigned int endIndex = graph.indexOf(endVertex);
+
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    ContractionSearchStats work{0, 0};
+
+    thread_local Search search;
+    search.prepare(graph.vertexCount());
+
+    std::vector<double>* distances = search.distances;
+
+    using Entry = std::pair<double, unsigned int>;
+    using Queue = std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>;
+    Queue pq[2];
+
+    // Index 0 is the forward search, which follows upward arcs from the
+    // start vertex, and index 1 is the backward search, which follows
+    // downward arcs (against their direction) from the end vertex.
+    distances[0][startIndex] = 0.0;
+    distances[1][endIndex] = 0.0;
+    search.touched.push_back(startIndex);
+    search.touched.push_back(endIndex);
+    pq[0].emplace(0.0, startIndex);
+    pq[1].emplace(0.0, endIndex);
+
+    double bestDistance = infinity;
+    unsigned int meeting = startIndex;
+
+    // Neither search can stop when they first meet, since a path through
+    // a higher-ranked vertex may be shorter; each goes on until its
+    // nearest unsettled vertex is at least as far as the best path so far.
+    while (true)
+    {
+        bool forwardDone = pq[0].empty() || pq[0].top().first >= bestDistance;
+        bool backwardDone = pq[1].empty() || pq[1].top().first >= bestDistance;
+
+        if (forwardDone && backwardDone)
+        {
+            break;
+        }
+
+        int side = backwardDone || (!forwardDone && pq[0].top().first <= pq[1].top().first) ? 0 : 1;
+        int other = 1 - side;
+
+        auto [distance, v] = pq[side].top();
+        pq[side].pop();
+
+        if (distance > distances[side][v])
+        {
+            continue;
+        }
+
+        ++work.settledVertices;
+
+        if (distances[other][v] != infinity && distance + distances[other][v] < bestDistance)
+        {
+            bestDistance = distance + distances[other][v];
+            meeting = v;
+        }
+
+        const std::vector<unsigned int>& offsets = side == 0 ? upOffsets : downOffsets;
+        const std::vector<Arc>& arcs = side == 0 ? upArcs : downArcs;
+        const std::vector<unsigned int>& oppositeOffsets = side == 0 ? downOffsets : upOffsets;
+        const std::vector<Arc>& oppositeArcs = side == 0 ? downArcs : upArcs;
+
+        // Stall-on-demand: if a higher-ranked vertex that this search has
+        // reached has an arc to v (in this search's direction) that gives
+        // a shorter path than the one by which v was settled, then v's
+        // distance isn't really a shortest one, and nothing reached
+        // through it can be on a shortest path, so its arcs are skipped.
+        bool stalled = false;
+
+        for (unsigned int a = oppositeOffsets[v]; a < oppositeOffsets[v + 1] && !stalled; ++a)
+        {
+            const Arc& arc = oppositeArcs[a];
+            stalled = distances[side][arc.vertex] + arc.weight < distance;
+        }
+
+        if (stalled)
+        {
+            ++work.stalledVertices;
+            continue;
+        }
+
+        for (unsigned int a = offsets[v]; a < offsets[v + 1]; ++a)
+        {
+            const Arc& arc = arcs[a];
+            double throughV = distance + arc.weight;
+
+            if (throughV < distances[side][arc.vertex])
+            {
+                if (distances[0][arc.vertex] == infinity && distances[1][arc.vertex] == infinity)
+                {
+                    search.touched.push_back(arc.vertex);
+                }
+
+                distances[side][arc.vertex] = throughV;
+                search.parents[side][arc.vertex] = v;
+                search.parentArcs[side][arc.vertex] = &arc;
+                pq[side].emplace(throughV, arc.vertex);
+            }
+        }
+    }
+
+    if (stats != nullptr)
+    {
+        *stats = work;
+    }
+
+    if (bestDistance == infinity)
+    {
+        search.reset();
+        return ShortestPath{{}, {}, infinity};
+    }
+
+    // The path through the hierarchy runs up from the start vertex to the
+    // meeting vertex and back down to the end vertex; each of its arcs is
+    // then unpacked.
+    struct Step
+    {
+        unsigned int from;
+        unsigned int to;
+        const Arc* arc;
+    };
+
+    std::vector<Step> steps;
+
+    for (unsigned int v = meeting; v != startIndex; v = search.parents[0][v])
+    {
+        steps.push_back(Step{search.parents[0][v], v, search.parentArcs[0][v]});
+    }
+
+    std::reverse(steps.begin(), steps.end());
+
+    for (unsigned int v = meeting; v != endIndex; v = search.parents[1][v])
+    {
+        steps.push_back(Step{v, search.parents[1][v], search.parentArcs[1][v]});
+    }
+
+    search.reset();
+
+    ShortestPath path{{startVertex}, {}, 0.0};
+
+    for (const Step& step : steps)
+    {
+        unpack(step.from, step.to, step.arc->weight, step.arc->middle, path);
+    }
+
+    // As in FrozenDigraph::tracePath(), the total is the sum of the
+    // segments in path order, so it's exactly what a Dijkstra search of
+    // the FrozenDigraph would find for the same path.
+    for (double segmentWeight : path.segmentWeights)
+    {
+        path.totalWeight += segmentWeight;
+    }
+
+    return path;
+}
+
+
+inline void ContractionHierarchy::unpack(
+    unsigned int from, unsigned int to, double weight, unsigned int middle,
+    ShortestPath& path) const
+{
+    if (middle == NO_MIDDLE)
+    {
+        path.vertices.push_back(graph.vertexNumber(to));
+        path.segmentWeights.push_back(weight);
+        return;
+    }
+
+    // The middle vertex was contracted before both ends of the shortcut,
+    // so the two arcs that the shortcut replaced were recorded with it:
+    // the one from "from" among its downward arcs and the one to "to"
+    // among its upward arcs.
+    const Arc& first = findArc(downArcs, downOffsets[middle], downOffsets[middle + 1], from);
+    const Arc& second = findArc(upArcs, upOffsets[middle], upOffsets[middle + 1], to);
+
+    unpack(from, middle, first.weight, first.middle, path);
+    unpack(middle, to, second.weight, second.middle, path);
+}
+
+
+inline const ContractionHierarchy::Arc& ContractionHierarchy::findArc(
+    const std::vector<Arc>& arcs, unsigned int first, unsigned int last, unsigned int vertex)
+{
+    for (unsigned int a = first; a < last; ++a)
+    {
+        if (arcs[a].vertex == vertex)
+        {
+            return arcs[a];
+        }
+    }
+
+    throw DigraphException{"Contraction hierarchy is missing an arc"};
+}
+
+
+
+#endif
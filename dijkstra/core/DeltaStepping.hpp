@@ -0,0 +1,673 @@
+// DeltaStepping.hpp
+//
+// A DeltaStepping finds the shortest paths from one vertex of a
+// FrozenDigraph to every other, like FrozenDigraph::shortestPaths(), but
+// spreads the work across several threads, using what's called the
+// delta-stepping algorithm.
+//
+// Dijkstra's algorithm settles one vertex at a time, which leaves nothing
+// for a second thread to do.  Delta-stepping instead sorts the vertices
+// into "buckets" by their tentative distances, each bucket covering a
+// range of distances delta wide, and settles a whole bucket at a time:
+//
+// * An edge is "light" if its weight is less than delta and "heavy"
+//   otherwise.  Relaxing a light edge can put a vertex into the bucket
+//   being settled, while relaxing a heavy edge never can.
+// * The vertices in the lowest nonempty bucket have their light edges
+//   relaxed, all in parallel, which may put more vertices into that
+//   bucket (or move the ones there to a shorter distance); this repeats
+//   until the bucket stays empty.
+// * The heavy edges of every vertex settled in that bucket are then
+//   relaxed once, in parallel, since their distances are now final.
+//
+// A larger delta puts more vertices into each bucket, giving the threads
+// more to do in parallel, at the cost of relaxing edges from vertices
+// whose distances aren't final yet, which is wasted work.  A delta around
+// the typical edge weight is a reasonable place to start.
+//
+// Each thread keeps its own buckets, holding the vertices whose distances
+// it lowered, so that the threads never share a bucket.  A distance is
+// lowered by an atomic compare-and-swap, so that when two threads find
+// paths to the same vertex at once, the shorter path wins.
+//
+// The buckets are kept in a cyclic array, a "window" covering a fixed
+// number of buckets however far the distances go: at least two more than
+// the heaviest edge spans, but never more than MAX_WINDOW_BUCKETS.
+// Vertices beyond the window wait in an overflow list, and once every
+// bucket in the window is empty, the window moves on to the lowest of
+// them.
+//
+// The predecessors are not recorded during the search, since the order in
+// which the threads happen to lower a vertex's distance would decide which
+// of several equally short paths is kept.  Instead, once the distances are
+// known, each vertex's predecessor is chosen the way Dijkstra's algorithm
+// would have chosen it, so that the results are exactly those of
+// FrozenDigraph::shortestPaths() and findShortestPaths().  (Edges of
+// weight 0 can make Dijkstra's choice depend on the order in which it
+// happens to settle vertices at the same distance; when they do, the
+// predecessors are found by running Dijkstra's algorithm instead, as are
+// the distances when they're too many buckets wide to number.)
+//
+// A DeltaStepping refers to the FrozenDigraph it was built from, which
+// must outlive it.  Its weights must not be negative.
+
+#ifndef DELTASTEPPING_HPP
+#define DELTASTEPPING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "DigraphException.hpp"
+#include "FrozenDigraph.hpp"
+
+
+
+class DeltaStepping
+{
+public:
+    // The most buckets that the window of buckets ever covers.
+    static constexpr std::size_t MAX_WINDOW_BUCKETS = 4096;
+
+    // Builds a DeltaStepping for searches of the given FrozenDigraph using
+    // the weights in the given column, with the given bucket width, on the
+    // given number of threads (or one per core, if it's 0).  The edges
+    // are sorted into light and heavy ones here, once.  A DigraphException
+    // is thrown if delta isn't positive.
+    DeltaStepping(
+        const FrozenDigraph& graph, unsigned int column, double delta,
+        unsigned int threadCount = 0);
+
+
+    // delta() returns the width of the buckets.
+    double delta() const noexcept;
+
+
+    // threadCount() returns the number of threads each search uses.
+    unsigned int threadCount() const noexcept;
+
+
+    // shortestPaths() is like FrozenDigraph::shortestPaths(), and leaves
+    // the same distances and predecessors.
+    void shortestPaths(
+        unsigned int startIndex,
+        std::vector<double>& distances, std::vector<unsigned int>& predecessors) const;
+
+
+    // findShortestPaths() is like FrozenDigraph::findShortestPaths(), and
+    // returns the same std::map.
+    std::map<int, int> findShortestPaths(int startVertex) const;
+
+
+private:
+    const FrozenDigraph& graph;
+    FrozenDigraph reversedGraph;
+    unsigned int column;
+    double width;
+    unsigned int threads;
+
+    // The edges leaving each vertex are stored in the same places as in
+    // the FrozenDigraph, but with its light edges first; the light edges
+    // leaving the vertex with index v end at lightEnds[v].
+    std::vector<unsigned int> targets;
+    std::vector<double> weights;
+    std::vector<unsigned int> lightEnds;
+
+    // The number of buckets in the window.
+    std::size_t windowBuckets;
+
+
+    // A Barrier holds back each thread that reaches it until all of them
+    // have, which separates the steps of a search.  It can be used again
+    // as soon as they've all been let through.
+    class Barrier
+    {
+    public:
+        explicit Barrier(unsigned int count);
+        void arriveAndWait();
+
+    private:
+        std::mutex mutex;
+        std::condition_variable allArrived;
+        unsigned int count;
+        unsigned int waiting;
+        unsigned long long generation;
+    };
+
+
+    // A Worker is what one thread keeps to itself during a search: its
+    // window of buckets and its overflow list, the vertices it took out of
+    // the bucket being settled, and the vertices it settled there, whose
+    // heavy edges are still to be relaxed.  Below "lowest", every bucket
+    // in its window is empty.  Each one is kept on its own cache lines, so
+    // that threads updating their own don't slow down each other.
+    struct alignas(64) Worker
+    {
+        std::vector<std::vector<unsigned int>> buckets;
+        std::vector<unsigned int> overflow;
+        std::size_t lowest = 0;
+        std::vector<unsigned int> current;
+        std::vector<unsigned int> settled;
+    };
+
+
+    // search() finds the distances, leaving the predecessors to
+    // choosePredecessors(); each returns false if it can't be sure of
+    // doing its part as Dijkstra's algorithm would.
+    bool search(unsigned int startIndex, std::vector<double>& distances) const;
+
+    bool choosePredecessors(
+        unsigned int startIndex, const std::vector<double>& distances,
+        std::vector<unsigned int>& predecessors) const;
+
+    // runOnThreads() calls work(t) for every t from 0 up to the number of
+    // threads, each on its own thread.
+    template <typename Work>
+    void runOnThreads(Work work) const;
+};
+
+
+
+inline DeltaStepping::DeltaStepping(
+    const FrozenDigraph& graph, unsigned int column, double delta,
+    unsigned int threadCount)
+    : graph{graph}, reversedGraph{graph.reversed()}, column{column}, width{delta},
+      threads{threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())}
+{
+    if (!(delta > 0.0))
+    {
+        throw DigraphException{"Delta must be positive"};
+    }
+
+    if (column >= graph.columnCount())
+    {
+        throw DigraphException{"Weight column does not exist."};
+    }
+
+    const std::vector<double>& weight = graph.weights(column);
+
+    targets.resize(graph.edgeCount());
+    weights.resize(graph.edgeCount());
+    lightEnds.resize(graph.vertexCount());
+
+    for (unsigned int v = 0; v < graph.vertexCount(); ++v)
+    {
+        unsigned int light = graph.firstEdge(v);
+        unsigned int heavy = graph.lastEdge(v);
+
+        // Light edges are placed from the front of the vertex's range and
+        // heavy ones from the back, so that the two meet in the middle.
+        for (unsigned int e = graph.firstEdge(v); e < graph.lastEdge(v); ++e)
+        {
+            unsigned int place = weight[e] < width ? light++ : --heavy;
+            targets[place] = graph.target(e);
+            weights[place] = weight[e];
+        }
+
+        lightEnds[v] = light;
+    }
+
+    // An edge from the bucket being settled leads at most this many
+    // buckets beyond it.  Infinite weights never lower a distance, so they
+    // aren't counted.
+    double widest = 0.0;
+
+    for (double w : weight)
+    {
+        if (w != std::numeric_limits<double>::infinity())
+        {
+            widest = std::max(widest, w / width);
+        }
+    }
+
+    windowBuckets = widest < MAX_WINDOW_BUCKETS - 2
+        ? static_cast<std::size_t>(widest) + 2 : MAX_WINDOW_BUCKETS;
+}
+
+
+inline double DeltaStepping::delta() const noexcept
+{
+    return width;
+}
+
+
+inline unsigned int DeltaStepping::threadCount() const noexcept
+{
+    return threads;
+}
+
+
+inline void DeltaStepping::shortestPaths(
+    unsigned int startIndex,
+    std::vector<double>& distances, std::vector<unsigned int>& predecessors) const
+{
+    if (!search(startIndex, distances) || !choosePredecessors(startIndex, distances, predecessors))
+    {
+        graph.shortestPaths(startIndex, column, distances, predecessors);
+    }
+}
+
+
+inline std::map<int, int> DeltaStepping::findShortestPaths(int startVertex) const
+{
+    std::vector<double> distances;
+    std::vector<unsigned int> predecessors(graph.vertexCount());
+
+    if (graph.contains(startVertex))
+    {
+        shortestPaths(graph.indexOf(startVertex), distances, predecessors);
+    }
+    else
+    {
+        for (unsigned int v = 0; v < predecessors.size(); ++v)
+        {
+            predecessors[v] = v;
+        }
+    }
+
+    std::map<int, int> paths;
+
+    for (unsigned int v = 0; v < predecessors.size(); ++v)
+    {
+        paths.emplace(graph.vertexNumber(v), graph.vertexNumber(predecessors[v]));
+    }
+
+    return paths;
+}
+
+
+inline DeltaStepping::Barrier::Barrier(unsigned int count)
+    : count{count}, waiting{0}, generation{0}
+{
+}
+
+
+inline void DeltaStepping::Barrier::arriveAndWait()
+{
+    std::unique_lock<std::mutex> lock{mutex};
+    unsigned long long arrivedIn = generation;
+
+    if (++waiting == count)
+    {
+        waiting = 0;
+        ++generation;
+        allArrived.notify_all();
+    }
+    else
+    {
+        allArrived.wait(lock, [&] { return generation != arrivedIn; });
+    }
+}
+
+
+inline bool DeltaStepping::search(unsigned int startIndex, std::vector<double>& distances) const
+{
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    constexpr std::size_t noBucket = std::numeric_limits<std::size_t>::max();
+    constexpr std::size_t chunkSize = 64;
+
+    // Buckets are numbered from 0, and a distance that would be in a
+    // bucket numbered this high or higher can't be numbered exactly.
+    constexpr double bucketLimit = 0x1.0p52;
+
+    unsigned int vertexCount = graph.vertexCount();
+
+    // tentative[v] is the shortest distance to v found so far, and
+    // expandedAt[v] the distance at which v's light edges were last
+    // relaxed, so that a vertex that appears in a bucket more than once
+    // at the same distance is only expanded once.
+    std::vector<std::atomic<double>> tentative(vertexCount);
+    std::vector<std::atomic<double>> expandedAt(vertexCount);
+
+    for (unsigned int v = 0; v < vertexCount; ++v)
+    {
+        tentative[v].store(infinity, std::memory_order_relaxed);
+        expandedAt[v].store(infinity, std::memory_order_relaxed);
+    }
+
+    std::vector<Worker> workers(threads);
+    std::vector<std::size_t> lowestBuckets(threads);
+    std::vector<std::size_t> currentSizes(threads);
+    std::atomic<std::size_t> nextItem{0};
+    std::atomic<bool> tooFar{false};
+    Barrier barrier{threads};
+
+    for (Worker& worker : workers)
+    {
+        worker.buckets.resize(windowBuckets);
+    }
+
+    tentative[startIndex].store(0.0, std::memory_order_relaxed);
+    workers[0].buckets[0].push_back(startIndex);
+
+    auto bucketOf =
+        [&](unsigned int v)
+        {
+            return static_cast<std::size_t>(tentative[v].load(std::memory_order_relaxed) / width);
+        };
+
+    // The barriers order every step of the search after the one before
+    // it, so the atomic operations themselves needn't order anything.
+    // Every thread's window starts at the same bucket, windowStart.
+    auto relax =
+        [&](Worker& worker, std::size_t windowStart, unsigned int w, double throughV)
+        {
+            double known = tentative[w].load(std::memory_order_relaxed);
+
+            while (throughV < known)
+            {
+                if (tentative[w].compare_exchange_weak(known, throughV, std::memory_order_relaxed))
+                {
+                    double position = throughV / width;
+
+                    if (!(position < bucketLimit))
+                    {
+                        tooFar.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    std::size_t bucket = static_cast<std::size_t>(position);
+
+                    if (bucket < windowStart + windowBuckets)
+                    {
+                        worker.buckets[bucket % windowBuckets].push_back(w);
+                        worker.lowest = std::min(worker.lowest, bucket);
+                    }
+                    else
+                    {
+                        worker.overflow.push_back(w);
+                    }
+
+                    return;
+                }
+            }
+        };
+
+    auto expand =
+        [&](Worker& worker, std::size_t windowStart, unsigned int v)
+        {
+            double distance = tentative[v].load(std::memory_order_relaxed);
+            double expanded = expandedAt[v].exchange(distance, std::memory_order_relaxed);
+
+            if (expanded == distance)
+            {
+                return;
+            }
+
+            // Only the first thread to expand a vertex in this bucket sees
+            // that it was never expanded before, so only that one adds it
+            // to its settled vertices.
+            if (expanded == infinity)
+            {
+                worker.settled.push_back(v);
+            }
+
+            for (unsigned int e = graph.firstEdge(v); e < lightEnds[v]; ++e)
+            {
+                relax(worker, windowStart, targets[e], distance + weights[e]);
+            }
+        };
+
+    runOnThreads(
+        [&](unsigned int t)
+        {
+            Worker& worker = workers[t];
+            std::size_t windowStart = 0;
+            std::size_t bucket = 0;
+
+            while (true)
+            {
+                // Every thread says which is its lowest nonempty bucket in
+                // the window, and the lowest of those is settled next.
+                std::size_t windowEnd = windowStart + windowBuckets;
+                std::size_t lowest = std::max(bucket, worker.lowest);
+
+                while (lowest < windowEnd && worker.buckets[lowest % windowBuckets].empty())
+                {
+                    ++lowest;
+                }
+
+                worker.lowest = lowest;
+                lowestBuckets[t] = lowest < windowEnd ? lowest : noBucket;
+                barrier.arriveAndWait();
+
+                bucket = *std::min_element(lowestBuckets.begin(), lowestBuckets.end());
+
+                if (bucket == noBucket)
+                {
+                    // The window is empty, so it moves on to the lowest
+                    // bucket of any vertex waiting in an overflow list.
+                    // Vertices whose distances have since been lowered
+                    // into the window were added to it then, and are
+                    // dropped.  (No thread writes to lowestBuckets again
+                    // until every thread has read it.)
+                    barrier.arriveAndWait();
+
+                    std::size_t lowestWaiting = noBucket;
+                    std::size_t kept = 0;
+
+                    for (unsigned int v : worker.overflow)
+                    {
+                        if (bucketOf(v) >= windowEnd)
+                        {
+                            lowestWaiting = std::min(lowestWaiting, bucketOf(v));
+                            worker.overflow[kept++] = v;
+                        }
+                    }
+
+                    worker.overflow.resize(kept);
+                    lowestBuckets[t] = lowestWaiting;
+                    barrier.arriveAndWait();
+
+                    windowStart = *std::min_element(lowestBuckets.begin(), lowestBuckets.end());
+
+                    if (windowStart == noBucket)
+                    {
+                        break;
+                    }
+
+                    windowEnd = windowStart + windowBuckets;
+                    bucket = windowStart;
+                    worker.lowest = windowStart;
+                    kept = 0;
+
+                    for (unsigned int v : worker.overflow)
+                    {
+                        if (bucketOf(v) < windowEnd)
+                        {
+                            worker.buckets[bucketOf(v) % windowBuckets].push_back(v);
+                        }
+                        else
+                        {
+                            worker.overflow[kept++] = v;
+                        }
+                    }
+
+                    worker.overflow.resize(kept);
+
+                    // The lowest buckets are found again, now that the
+                    // window has moved, once every thread has read where
+                    // it moved to.
+                    barrier.arriveAndWait();
+                    continue;
+                }
+
+                while (true)
+                {
+                    // Each thread takes the vertices out of its own part of
+                    // the bucket, then the threads share out all of them in
+                    // chunks, so that one thread whose part is large doesn't
+                    // hold up the others.
+                    worker.current.clear();
+                    worker.current.swap(worker.buckets[bucket % windowBuckets]);
+                    currentSizes[t] = worker.current.size();
+
+                    if (t == 0)
+                    {
+                        nextItem.store(0, std::memory_order_relaxed);
+                    }
+
+                    barrier.arriveAndWait();
+
+                    std::size_t total = 0;
+
+                    for (std::size_t size : currentSizes)
+                    {
+                        total += size;
+                    }
+
+                    if (total == 0)
+                    {
+                        break;
+                    }
+
+                    for (std::size_t first = nextItem.fetch_add(chunkSize, std::memory_order_relaxed);
+                         first < total;
+                         first = nextItem.fetch_add(chunkSize, std::memory_order_relaxed))
+                    {
+                        std::size_t item = first;
+                        std::size_t last = std::min(first + chunkSize, total);
+                        unsigned int owner = 0;
+
+                        while (item >= currentSizes[owner])
+                        {
+                            item -= currentSizes[owner];
+                            ++owner;
+                        }
+
+                        for (std::size_t i = first; i < last; ++i, ++item)
+                        {
+                            while (item >= currentSizes[owner])
+                            {
+                                item = 0;
+                                ++owner;
+                            }
+
+                            expand(worker, windowStart, workers[owner].current[item]);
+                        }
+                    }
+
+                    barrier.arriveAndWait();
+                }
+
+                // The bucket stays empty, so the distances of the vertices
+                // settled in it are final, and their heavy edges can be
+                // relaxed.  These only ever lead to later buckets.
+                for (unsigned int v : worker.settled)
+                {
+                    double distance = tentative[v].load(std::memory_order_relaxed);
+
+                    for (unsigned int e = lightEnds[v]; e < graph.lastEdge(v); ++e)
+                    {
+                        relax(worker, windowStart, targets[e], distance + weights[e]);
+                    }
+                }
+
+                worker.settled.clear();
+            }
+        });
+
+    distances.resize(vertexCount);
+
+    for (unsigned int v = 0; v < vertexCount; ++v)
+    {
+        distances[v] = tentative[v].load(std::memory_order_relaxed);
+    }
+
+    return !tooFar.load(std::memory_order_relaxed);
+}
+
+
+inline bool DeltaStepping::choosePredecessors(
+    unsigned int startIndex, const std::vector<double>& distances,
+    std::vector<unsigned int>& predecessors) const
+{
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    unsigned int vertexCount = graph.vertexCount();
+    const std::vector<double>& reverseWeight = reversedGraph.weights(column);
+    std::atomic<bool> tied{false};
+
+    predecessors.resize(vertexCount);
+
+    // Dijkstra's algorithm keeps, as each vertex's predecessor, the first
+    // vertex it settles whose distance plus the weight of its edge equals
+    // that vertex's distance.  When every such edge leads from a shorter
+    // distance to a longer one, it settles vertices in order of distance,
+    // and, among equal distances, in order of index, since that's how
+    // its priority queue orders them.  So the predecessor is the one
+    // with the shortest distance and, among those, the lowest index.
+    //
+    // When such an edge joins two vertices at the same distance, as an
+    // edge of weight 0 does, the order in which they're settled depends
+    // on more than that, and it's left to Dijkstra's algorithm itself.
+    runOnThreads(
+        [&](unsigned int t)
+        {
+            for (unsigned int w = t; w < vertexCount; w += threads)
+            {
+                predecessors[w] = w;
+
+                if (w == startIndex || distances[w] == infinity)
+                {
+                    continue;
+                }
+
+                for (unsigned int e = reversedGraph.firstEdge(w); e < reversedGraph.lastEdge(w); ++e)
+                {
+                    unsigned int v = reversedGraph.target(e);
+
+                    if (v == w || distances[v] + reverseWeight[e] != distances[w])
+                    {
+                        continue;
+                    }
+
+                    if (distances[v] == distances[w])
+                    {
+                        tied.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    unsigned int best = predecessors[w];
+
+                    if (best == w || distances[v] < distances[best]
+                        || (distances[v] == distances[best] && v < best))
+                    {
+                        predecessors[w] = v;
+                    }
+                }
+            }
+        });
+
+    return !tied.load(std::memory_order_relaxed);
+}
+
+
+template <typename Work>
+void DeltaStepping::runOnThreads(Work work) const
+{
+    std::vector<std::thread> others;
+    others.reserve(threads - 1);
+
+    for (unsigned int t = 1; t < threads; ++t)
+    {
+        others.emplace_back(work, t);
+    }
+
+    // The calling thread does its share of the work, too.
+    work(0);
+
+    for (std::thread& other : others)
+    {
+        other.join();
+    }
+}
+
+
+
+#endif
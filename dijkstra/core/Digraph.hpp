@@ -6,11 +6,15 @@
 // This header file declares a class template called Digraph, which is
 // intended to implement a generic directed graph.  The implementation
 // uses the adjacency lists technique, so each vertex stores a linked
-// list of its outgoing edges.
+// list of its outgoing edges, and the vertices themselves are stored
+// densely, so each has an index from 0 to V - 1 as well as its number.
 //
-// Along with the Digraph class template is a class DigraphException
-// and a couple of utility structs that aren't generally useful outside
-// of this header file.
+// Along with the Digraph class template are a couple of utility structs
+// that aren't generally useful outside of this header file.  The
+// DigraphException class, thrown by some of its member functions, is
+// declared in DigraphException.hpp, and FrozenDigraph, an immutable
+// snapshot of a Digraph's structure that's faster to search, in
+// FrozenDigraph.hpp.
 //
 // In general, directed graphs are all the same, except in the sense
 // that they store different kinds of information about each vertex and
@@ -20,33 +24,23 @@
 #ifndef DIGRAPH_HPP
 #define DIGRAPH_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <deque>
 #include <exception>
 #include <functional>
+#include <limits>
 #include <list>
 #include <map>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
-
-#include <iostream>
-#include <queue>
-
-
-// DigraphExceptions are thrown from some of the member functions in the
-// Digraph class template, so that exception is declared here, so it
-// will be available to any code that includes this header file.
-
-class DigraphException : public std::runtime_error
-{
-public:
-    DigraphException(const std::string& reason);
-};
-
-
-inline DigraphException::DigraphException(const std::string& reason)
-    : std::runtime_error{reason}
-{
-}
-
+#include "DigraphException.hpp"
+#include "FrozenDigraph.hpp"
+#include "ShortestPath.hpp"
 
 
 // A DigraphEdge lists a "from vertex" (the number of the vertex from which
@@ -64,15 +58,18 @@ struct DigraphEdge
 
 
 
-// A DigraphVertex includes two things: a VertexInfo object and a list of
-// its outgoing edges.  Because different kinds of Digraphs store different
-// kinds of vertex and edge information, DigraphVertex is a struct template.
+// A DigraphVertex includes three things: a VertexInfo object, a list of
+// its outgoing edges, and pointers to its incoming edges, which live in
+// the lists belonging to the vertices they come from.  Because different
+// kinds of Digraphs store different kinds of vertex and edge information,
+// DigraphVertex is a struct template.
 
 template <typename VertexInfo, typename EdgeInfo>
 struct DigraphVertex
 {
     VertexInfo vinfo;
     std::list<DigraphEdge<EdgeInfo>> edges;
+    std::vector<const DigraphEdge<EdgeInfo>*> incomingEdges;
 };
 
 
@@ -200,28 +197,124 @@ public:
     // the algorithm.  For any vertex without a predecessor (e.g.,
     // a vertex that was never reached, or the start vertex itself),
     // the value is simply a copy of the key.
+    //
+    // Each vertex's outgoing edges are examined only once, when it is
+    // removed from a priority queue ordered by distance, so this runs in
+    // O((V + E) log V) time.
     std::map<int, int> findShortestPaths(
         int startVertex,
         std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
 
+    // This overload of findShortestPaths() accepts any kind of function
+    // object (e.g., a lambda) that can be called with an EdgeInfo object
+    // and returns an edge weight.  Unlike a std::function, calls to it can
+    // be inlined, so it's the better choice when the function is simple.
+    // The same goes for the overloads of findShortestPath(),
+    // findShortestPathBidirectional(), and freeze() below.
+    template <typename EdgeWeightFunc>
+    std::map<int, int> findShortestPaths(int startVertex, EdgeWeightFunc edgeWeightFunc) const;
+
+    // findShortestPath() takes a start vertex number, an end vertex
+    // number, and a function that determines edge weights, as
+    // findShortestPaths() does, and returns the shortest path from the
+    // start vertex to the end vertex: the vertices along it, the weight
+    // of each of its edges, and their total.  The search stops as soon
+    // as the end vertex's distance is known, rather than going on to
+    // find paths to every vertex.  A DigraphException is thrown if
+    // either vertex does not exist.
+    ShortestPath findShortestPath(
+        int startVertex, int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
 
-private:
-    // Add whatever member variables you think you need here.  One
-    // possibility is a std::map where the keys are vertex numbers
-    // and the values are DigraphVertex<VertexInfo, EdgeInfo> objects.
+    template <typename EdgeWeightFunc>
+    ShortestPath findShortestPath(int startVertex, int endVertex, EdgeWeightFunc edgeWeightFunc) const;
+
+    // findShortestPathBidirectional() returns the same path as
+    // findShortestPath(), but finds it by searching forward from the
+    // start vertex and backward (along incoming edges) from the end
+    // vertex at the same time, until the two searches meet.  Each search
+    // only has to reach about halfway, so on a large graph such as a road
+    // map, far fewer vertices are settled.  A DigraphException is thrown
+    // if either vertex does not exist.
+    ShortestPath findShortestPathBidirectional(
+        int startVertex, int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
 
+    template <typename EdgeWeightFunc>
+    ShortestPath findShortestPathBidirectional(
+        int startVertex, int endVertex, EdgeWeightFunc edgeWeightFunc) const;
+
+    // freeze() returns a FrozenDigraph with the same vertices and edges as
+    // this Digraph, and one weight column for each of the given functions,
+    // in the same order, holding what each function returns for each
+    // edge's EdgeInfo object.  The FrozenDigraph is unaffected by later
+    // changes to this Digraph.
+    //
+    // Freezing calls each function exactly once per edge, storing what it
+    // returns, so searching the FrozenDigraph afterward only ever loads
+    // edge weights.  When the same weights are used by many searches,
+    // freezing once and searching the FrozenDigraph is the way to avoid
+    // computing them over and over.
+    FrozenDigraph freeze(
+        const std::vector<std::function<double(const EdgeInfo&)>>& edgeWeightFuncs) const;
+
+    template <typename... EdgeWeightFuncs>
+    FrozenDigraph freeze(EdgeWeightFuncs... edgeWeightFuncs) const;
+
+    // version() returns a number that changes whenever vertices or edges
+    // are added to or removed from this Digraph, so that a FrozenDigraph
+    // whose sourceVersion() is different is out of date.
+    unsigned long long version() const noexcept;
 
-    // You can also feel free to add any additional member functions
-    // you'd like (public or private), so long as you don't remove or
-    // change the signatures of the ones that already exist.
-    std::map<int, DigraphVertex<VertexInfo,EdgeInfo>> vertexMap;
-};
 
+private:
+    // Vertices are stored densely, so that algorithms can keep their
+    // bookkeeping in flat arrays indexed the same way, rather than in
+    // maps keyed by vertex number.  A vertex's index is its position in
+    // vertexList; vertexIndices maps vertex numbers to indices and
+    // vertexNumbers maps them back.  Removing a vertex moves the last one
+    // into its place, so indices change when vertices are removed, but
+    // vertex numbers (including the ones stored in edges) never do.
+    //
+    // vertexList is a std::deque, not a std::vector, because incomingEdges
+    // points into other vertices' edge lists.  A std::vector copies its
+    // elements when it grows, unless they can be moved without throwing,
+    // which depends on VertexInfo (and on the library's std::list); the
+    // copies would have new edge lists, leaving those pointers dangling.
+    // A std::deque never moves its elements when it grows.
+    std::deque<DigraphVertex<VertexInfo, EdgeInfo>> vertexList;
+    std::vector<int> vertexNumbers;
+    std::unordered_map<int, unsigned int> vertexIndices;
+
+    unsigned long long modifications = 0;
+
+    // indexOf() returns the index of the vertex with the given vertex
+    // number.  If that vertex does not exist, a DigraphException is
+    // thrown instead.
+    unsigned int indexOf(int vertex) const;
+
+    // relinkIncomingEdges() rebuilds every vertex's incomingEdges from
+    // the outgoing edge lists, which is necessary after those lists have
+    // been copied from another Digraph.
+    void relinkIncomingEdges();
+
+    // unlinkIncomingEdge() removes the given edge from the incomingEdges
+    // of the vertex it points to.
+    void unlinkIncomingEdge(const DigraphEdge<EdgeInfo>& edge);
+
+    // freezeWith() builds a FrozenDigraph with the given number of weight
+    // columns, calling appendWeights(edge, weightColumns) to add each
+    // edge's weights to the columns.
+    template <typename AppendWeights>
+    FrozenDigraph freezeWith(std::size_t columnCount, AppendWeights appendWeights) const;
+
+    // reachesEveryVertex() returns true if every vertex can be reached
+    // from the vertex with index 0, following the edges forward or (if
+    // "reversed" is true) backward.
+    bool reachesEveryVertex(bool reversed) const;
+};
 
 
-// You'll need to implement the member functions below.  There's enough
-// code in place to make them compile, but they'll all need to do the
-// correct thing instead.
 
 template <typename VertexInfo, typename EdgeInfo>
 Digraph<VertexInfo, EdgeInfo>::Digraph()
@@ -231,30 +324,39 @@ Digraph<VertexInfo, EdgeInfo>::Digraph()
 
 template <typename VertexInfo, typename EdgeInfo>
 Digraph<VertexInfo, EdgeInfo>::Digraph(const Digraph& d)
+    : vertexList{d.vertexList}, vertexNumbers{d.vertexNumbers}, vertexIndices{d.vertexIndices}
 {
-    vertexMap = d.vertexMap;
+    relinkIncomingEdges();
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
 Digraph<VertexInfo, EdgeInfo>::Digraph(Digraph&& d) noexcept
 {
-    std::swap(vertexMap,d.vertexMap);
+    std::swap(vertexList, d.vertexList);
+    std::swap(vertexNumbers, d.vertexNumbers);
+    std::swap(vertexIndices, d.vertexIndices);
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
 Digraph<VertexInfo, EdgeInfo>::~Digraph() noexcept
 {
-    vertexMap.clear();
-    
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
 Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(const Digraph& d)
 {
-    vertexMap = d.vertexMap;
+    if (this != &d)
+    {
+        vertexList = d.vertexList;
+        vertexNumbers = d.vertexNumbers;
+        vertexIndices = d.vertexIndices;
+        relinkIncomingEdges();
+        ++modifications;
+    }
+
     return *this;
 }
 
@@ -262,7 +364,11 @@ Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(const Di
 template <typename VertexInfo, typename EdgeInfo>
 Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(Digraph&& d) noexcept
 {
-    std::swap(vertexMap,d.vertexMap);
+    std::swap(vertexList, d.vertexList);
+    std::swap(vertexNumbers, d.vertexNumbers);
+    std::swap(vertexIndices, d.vertexIndices);
+    ++modifications;
+    ++d.modifications;
     return *this;
 }
 
@@ -270,25 +376,20 @@ Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(Digraph&
 template <typename VertexInfo, typename EdgeInfo>
 std::vector<int> Digraph<VertexInfo, EdgeInfo>::vertices() const
 {
-    std::vector<int> vert;
-    for (typename std::map<int, DigraphVertex<VertexInfo,EdgeInfo>>::const_iterator it = vertexMap.begin(); it != vertexMap.end();it++)
-    {
-        vert.push_back(it->first);
-    }
-    return vert;
+    return vertexNumbers;
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
 std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges() const
 {
-    std::vector<std::pair<int,int>> vecEdges;
+    std::vector<std::pair<int, int>> vecEdges;
 
-    for (auto a = vertexMap.begin(); a != vertexMap.end(); a++)
+    for (const DigraphVertex<VertexInfo, EdgeInfo>& vertex : vertexList)
     {
-        for (auto b = a->second.edges.begin(); b != a->second.edges.end(); b++)
+        for (const DigraphEdge<EdgeInfo>& edge : vertex.edges)
         {
-            vecEdges.push_back(std::pair(b->fromVertex,b->toVertex));
+            vecEdges.emplace_back(edge.fromVertex, edge.toVertex);
         }
     }
 
@@ -299,16 +400,11 @@ std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges() const
 template <typename VertexInfo, typename EdgeInfo>
 std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges(int vertex) const
 {
-    std::vector<std::pair<int,int>> edg;
-    if (vertexMap.find(vertex) == vertexMap.end())
-    {
-       throw DigraphException{"Vertex does not exist."};
-    }
-    
-   
-    for (auto it = vertexMap.at(vertex).edges.begin(); it!= vertexMap.at(vertex).edges.end(); it++)
+    std::vector<std::pair<int, int>> edg;
+
+    for (const DigraphEdge<EdgeInfo>& edge : vertexList[indexOf(vertex)].edges)
     {
-            edg.push_back(std::pair(it->fromVertex, it->toVertex));
+        edg.emplace_back(edge.fromVertex, edge.toVertex);
     }
 
     return edg;
@@ -318,247 +414,595 @@ std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges(int vertex
 template <typename VertexInfo, typename EdgeInfo>
 VertexInfo Digraph<VertexInfo, EdgeInfo>::vertexInfo(int vertex) const
 {
-    if (vertexMap.find(vertex) == vertexMap.end())
-    {
-        throw DigraphException{"Vertex does not exist."};
-    }
-    return vertexMap.at(vertex).vinfo;
+    return vertexList[indexOf(vertex)].vinfo;
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
 EdgeInfo Digraph<VertexInfo, EdgeInfo>::edgeInfo(int fromVertex, int toVertex) const
 {
-    
-    if (vertexMap.find(fromVertex) == vertexMap.end() || vertexMap.find(toVertex) == vertexMap.end())
+    const DigraphVertex<VertexInfo, EdgeInfo>& from = vertexList[indexOf(fromVertex)];
+    indexOf(toVertex);
+
+    for (const DigraphEdge<EdgeInfo>& edge : from.edges)
     {
-        throw DigraphException{"Vertex does not exist"};
+        if (edge.toVertex == toVertex)
+        {
+            return edge.einfo;
+        }
     }
-    for (auto it = vertexMap.at(fromVertex).edges.begin(); it!= vertexMap.at(fromVertex).edges.end(); it++)
+
+    throw DigraphException{"Edge does not exist"};
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void Digraph<VertexInfo, EdgeInfo>::addVertex(int vertex, const VertexInfo& vinfo)
+{
+    if (vertexIndices.count(vertex) != 0)
     {
-            if (it->toVertex ==  toVertex)
-            {
-                return it->einfo;
-            }
+        throw DigraphException{"Vertex exists already"};
     }
 
-     throw DigraphException{"Edge does not exist"};
+    vertexList.push_back(DigraphVertex<VertexInfo, EdgeInfo>{vinfo, {}, {}});
+    vertexNumbers.push_back(vertex);
+    vertexIndices.emplace(vertex, vertexList.size() - 1);
+    ++modifications;
+}
 
 
+template <typename VertexInfo, typename EdgeInfo>
+void Digraph<VertexInfo, EdgeInfo>::addEdge(int fromVertex, int toVertex, const EdgeInfo& einfo)
+{
+    DigraphVertex<VertexInfo, EdgeInfo>& from = vertexList[indexOf(fromVertex)];
+    indexOf(toVertex);
+
+    for (const DigraphEdge<EdgeInfo>& edge : from.edges)
+    {
+        if (edge.toVertex == toVertex)
+        {
+            throw DigraphException{"Edge is present"};
+        }
+    }
+
+    from.edges.push_back(DigraphEdge<EdgeInfo>{fromVertex, toVertex, einfo});
+    vertexList[indexOf(toVertex)].incomingEdges.push_back(&from.edges.back());
+    ++modifications;
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::addVertex(int vertex, const VertexInfo& vinfo)
+void Digraph<VertexInfo, EdgeInfo>::removeVertex(int vertex)
 {
-    if (vertexMap.count(vertex) != 0)
+    unsigned int index = indexOf(vertex);
+    unsigned int last = vertexList.size() - 1;
+    DigraphVertex<VertexInfo, EdgeInfo>& removed = vertexList[index];
+
+    // Only the vertex's neighbors refer to its edges, so only they need
+    // to change; loops (edges from the vertex to itself) disappear along
+    // with the vertex.
+    for (const DigraphEdge<EdgeInfo>& edge : removed.edges)
     {
-         throw DigraphException{"Vertex exists already"};
+        if (edge.toVertex != vertex)
+        {
+            unlinkIncomingEdge(edge);
+        }
+    }
+
+    for (const DigraphEdge<EdgeInfo>* incoming : removed.incomingEdges)
+    {
+        if (incoming->fromVertex != vertex)
+        {
+            vertexList[vertexIndices.at(incoming->fromVertex)].edges.remove_if(
+                [incoming](const DigraphEdge<EdgeInfo>& edge)
+                {
+                    return &edge == incoming;
+                });
+        }
+    }
 
+    // The last vertex takes the removed one's place.  Swapping its edge
+    // list into place moves the list's nodes along with it, so pointers
+    // to its edges remain valid.
+    if (index != last)
+    {
+        DigraphVertex<VertexInfo, EdgeInfo>& moved = vertexList[last];
+        removed.vinfo = std::move(moved.vinfo);
+        removed.edges.swap(moved.edges);
+        removed.incomingEdges.swap(moved.incomingEdges);
+        vertexNumbers[index] = vertexNumbers[last];
+        vertexIndices[vertexNumbers[index]] = index;
     }
-    vertexMap.insert(std::pair(vertex, DigraphVertex<VertexInfo, EdgeInfo>{vinfo}));
 
+    vertexList.pop_back();
+    vertexNumbers.pop_back();
+    vertexIndices.erase(vertex);
+    ++modifications;
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::addEdge(int fromVertex, int toVertex, const EdgeInfo& einfo)
+void Digraph<VertexInfo, EdgeInfo>::removeEdge(int fromVertex, int toVertex)
 {
-    if (vertexMap.find(fromVertex) == vertexMap.end() || vertexMap.find(toVertex) == vertexMap.end())
+    DigraphVertex<VertexInfo, EdgeInfo>& from = vertexList[indexOf(fromVertex)];
+    indexOf(toVertex);
+
+    for (auto i = from.edges.begin(); i != from.edges.end(); ++i)
     {
-        throw DigraphException{"Vertex does not exist"};
+        if (i->toVertex == toVertex)
+        {
+            unlinkIncomingEdge(*i);
+            from.edges.erase(i);
+            ++modifications;
+            return;
+        }
     }
 
-    std::vector<std::pair<int,int>> edgTemp = edges(fromVertex);
-    if (std::find(edgTemp.begin(),edgTemp.end(), std::pair(fromVertex,toVertex)) != edgTemp.end())
+    throw DigraphException{"Edge does not exist"};
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int Digraph<VertexInfo, EdgeInfo>::vertexCount() const noexcept
+{
+    return vertexList.size();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int Digraph<VertexInfo, EdgeInfo>::edgeCount() const noexcept
+{
+    int count = 0;
+
+    for (const DigraphVertex<VertexInfo, EdgeInfo>& vertex : vertexList)
     {
-        throw DigraphException{"Edge is present"};
+        count += vertex.edges.size();
     }
 
-    vertexMap.at(fromVertex).edges.push_back(DigraphEdge<EdgeInfo>{fromVertex,toVertex,einfo});
+    return count;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int Digraph<VertexInfo, EdgeInfo>::edgeCount(int vertex) const
+{
+    return vertexList[indexOf(vertex)].edges.size();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+bool Digraph<VertexInfo, EdgeInfo>::isStronglyConnected() const
+{
+    // Every vertex can reach every other if and only if one vertex can
+    // reach all of them, and all of them can reach it.
+    return reachesEveryVertex(false) && reachesEveryVertex(true);
+}
 
 
+template <typename VertexInfo, typename EdgeInfo>
+std::map<int, int> Digraph<VertexInfo, EdgeInfo>::findShortestPaths(
+    int startVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    return findShortestPaths<std::function<double(const EdgeInfo&)>>(startVertex, edgeWeightFunc);
+}
 
 
+template <typename VertexInfo, typename EdgeInfo>
+template <typename EdgeWeightFunc>
+std::map<int, int> Digraph<VertexInfo, EdgeInfo>::findShortestPaths(
+    int startVertex, EdgeWeightFunc edgeWeightFunc) const
+{
+    // Freezing takes time proportional to the size of the graph, which
+    // the search would need anyway, and the search itself is much faster
+    // on the frozen graph's flat arrays.
+    return freeze(edgeWeightFunc).findShortestPaths(startVertex);
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::removeVertex(int vertex)
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPath(
+    int startVertex, int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
 {
-     if (vertexMap.count(vertex) == 0)
-    {
-        throw DigraphException{"Vertex does not exist."};
-    }
+    return findShortestPath<std::function<double(const EdgeInfo&)>>(startVertex, endVertex, edgeWeightFunc);
+}
+
 
-    vertexMap.erase(vertex);
+template <typename VertexInfo, typename EdgeInfo>
+template <typename EdgeWeightFunc>
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPath(
+    int startVertex, int endVertex, EdgeWeightFunc edgeWeightFunc) const
+{
+    unsigned int startIndex = indexOf(startVertex);
+    unsigned int endIndex = indexOf(endVertex);
 
-    for (auto it = vertexMap.begin(); it!= vertexMap.end(); it++)
+    // Unlike findShortestPaths(), this doesn't freeze the Digraph first,
+    // because that would visit every edge, where an early stop might
+    // visit only a few.  Each vertex instead records the edge by which
+    // it was reached, so that the path can be rebuilt from those edges.
+    std::vector<double> distances(vertexList.size(), std::numeric_limits<double>::infinity());
+    std::vector<const DigraphEdge<EdgeInfo>*> predecessorEdges(vertexList.size(), nullptr);
+    std::vector<bool> known(vertexList.size(), false);
+
+    using Entry = std::pair<double, unsigned int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+
+    distances[startIndex] = 0.0;
+    pq.emplace(0.0, startIndex);
+
+    while (!pq.empty())
     {
-        for (auto i = it->second.edges.begin(); i != it->second.edges.end(); i ++)
+        auto [distance, v] = pq.top();
+        pq.pop();
+
+        if (known[v])
         {
-            if (i->toVertex ==  vertex)
+            continue;
+        }
+
+        known[v] = true;
+
+        if (v == endIndex)
+        {
+            break;
+        }
+
+        for (const DigraphEdge<EdgeInfo>& edge : vertexList[v].edges)
+        {
+            unsigned int w = vertexIndices.at(edge.toVertex);
+            double throughV = distance + edgeWeightFunc(edge.einfo);
+
+            if (!known[w] && throughV < distances[w])
             {
-                vertexMap.at(i->fromVertex).edges.erase(i);
+                distances[w] = throughV;
+                predecessorEdges[w] = &edge;
+                pq.emplace(throughV, w);
             }
         }
     }
-    return;
 
+    ShortestPath path{{}, {}, distances[endIndex]};
+
+    if (!known[endIndex])
+    {
+        return path;
+    }
+
+    for (unsigned int w = endIndex; w != startIndex; )
+    {
+        const DigraphEdge<EdgeInfo>* edge = predecessorEdges[w];
+
+        path.vertices.push_back(edge->toVertex);
+        path.segmentWeights.push_back(edgeWeightFunc(edge->einfo));
+        w = vertexIndices.at(edge->fromVertex);
+    }
+
+    path.vertices.push_back(startVertex);
 
+    std::reverse(path.vertices.begin(), path.vertices.end());
+    std::reverse(path.segmentWeights.begin(), path.segmentWeights.end());
 
+    return path;
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::removeEdge(int fromVertex, int toVertex)
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPathBidirectional(
+    int startVertex, int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
 {
-    if (vertexMap.find(fromVertex) == vertexMap.end() || vertexMap.find(toVertex) == vertexMap.end())
+    return findShortestPathBidirectional<std::function<double(const EdgeInfo&)>>(
+        startVertex, endVertex, edgeWeightFunc);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename EdgeWeightFunc>
+ShortestPath Digraph<VertexInfo, EdgeInfo>::findShortestPathBidirectional(
+    int startVertex, int endVertex, EdgeWeightFunc edgeWeightFunc) const
+{
+    unsigned int startIndex = indexOf(startVertex);
+    unsigned int endIndex = indexOf(endVertex);
+
+    if (startIndex == endIndex)
     {
-        throw DigraphException{"Vertex does not exist"};
+        return ShortestPath{{startVertex}, {}, 0.0};
     }
 
-
-    std::vector<std::pair<int,int>> edgTemp = edges(fromVertex);
-    if (std::find(edgTemp.begin(),edgTemp.end(), std::pair(fromVertex,toVertex)) == edgTemp.end())
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    using Entry = std::pair<double, unsigned int>;
+    using Queue = std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>;
+
+    // Everything is kept twice, once for each direction: index 0 is the
+    // forward search from the start vertex and index 1 is the backward
+    // search from the end vertex.  A vertex's predecessor edge is the one
+    // by which its search reached it, so in the backward search it's an
+    // edge leaving the vertex rather than one entering it.
+    std::vector<double> distances[2];
+    std::vector<const DigraphEdge<EdgeInfo>*> predecessorEdges[2];
+    std::vector<bool> known[2];
+    Queue pq[2];
+
+    for (int side = 0; side < 2; ++side)
     {
-        throw DigraphException{"Edge does not exist"};
+        distances[side].assign(vertexList.size(), infinity);
+        predecessorEdges[side].assign(vertexList.size(), nullptr);
+        known[side].assign(vertexList.size(), false);
     }
-    
 
-     
-    for (auto i = vertexMap.at(fromVertex).edges.begin(); i!= vertexMap.at(fromVertex).edges.end(); i++)
+    distances[0][startIndex] = 0.0;
+    distances[1][endIndex] = 0.0;
+    pq[0].emplace(0.0, startIndex);
+    pq[1].emplace(0.0, endIndex);
+
+    // bestDistance (usually called mu) is the length of the shortest path
+    // seen so far that joins the two searches, and bestEdge is the edge
+    // at which they join on that path.
+    double bestDistance = infinity;
+    const DigraphEdge<EdgeInfo>* bestEdge = nullptr;
+
+    // The searches take turns by frontier size, so that neither spends
+    // its time on a part of the graph that's much bushier than the other.
+    // Once the nearest unsettled vertices on the two sides are together
+    // at least as far as bestDistance, no shorter path can exist.
+    while (!pq[0].empty() && !pq[1].empty()
+           && pq[0].top().first + pq[1].top().first < bestDistance)
     {
-            if (i->toVertex ==  toVertex)
+        int side = pq[0].size() <= pq[1].size() ? 0 : 1;
+        int other = 1 - side;
+
+        auto [distance, v] = pq[side].top();
+        pq[side].pop();
+
+        if (known[side][v])
+        {
+            continue;
+        }
+
+        known[side][v] = true;
+
+        auto relax =
+            [&](const DigraphEdge<EdgeInfo>& edge, int neighbor)
             {
-                vertexMap.at(fromVertex).edges.erase(i);
-                return;
+                unsigned int w = vertexIndices.at(neighbor);
+                double throughV = distance + edgeWeightFunc(edge.einfo);
+
+                if (!known[side][w] && throughV < distances[side][w])
+                {
+                    distances[side][w] = throughV;
+                    predecessorEdges[side][w] = &edge;
+                    pq[side].emplace(throughV, w);
+                }
+
+                if (throughV + distances[other][w] < bestDistance)
+                {
+                    bestDistance = throughV + distances[other][w];
+                    bestEdge = &edge;
+                }
+            };
 
+        if (side == 0)
+        {
+            for (const DigraphEdge<EdgeInfo>& edge : vertexList[v].edges)
+            {
+                relax(edge, edge.toVertex);
+            }
+        }
+        else
+        {
+            for (const DigraphEdge<EdgeInfo>* edge : vertexList[v].incomingEdges)
+            {
+                relax(*edge, edge->fromVertex);
             }
+        }
+    }
+
+    ShortestPath path{{}, {}, bestDistance};
+
+    if (bestEdge == nullptr)
+    {
+        return path;
     }
+
+    // The path is the forward search's path to the joining edge's "from"
+    // vertex, the joining edge, and the backward search's path from the
+    // joining edge's "to" vertex.
+    std::vector<const DigraphEdge<EdgeInfo>*> pathEdges;
+
+    for (unsigned int v = vertexIndices.at(bestEdge->fromVertex); v != startIndex; )
+    {
+        pathEdges.push_back(predecessorEdges[0][v]);
+        v = vertexIndices.at(predecessorEdges[0][v]->fromVertex);
+    }
+
+    std::reverse(pathEdges.begin(), pathEdges.end());
+    pathEdges.push_back(bestEdge);
+
+    for (unsigned int v = vertexIndices.at(bestEdge->toVertex); v != endIndex; )
+    {
+        pathEdges.push_back(predecessorEdges[1][v]);
+        v = vertexIndices.at(predecessorEdges[1][v]->toVertex);
+    }
+
+    path.vertices.push_back(startVertex);
+
+    for (const DigraphEdge<EdgeInfo>* edge : pathEdges)
+    {
+        path.vertices.push_back(edge->toVertex);
+        path.segmentWeights.push_back(edgeWeightFunc(edge->einfo));
+    }
+
+    return path;
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
-int Digraph<VertexInfo, EdgeInfo>::vertexCount() const noexcept
+FrozenDigraph Digraph<VertexInfo, EdgeInfo>::freeze(
+    const std::vector<std::function<double(const EdgeInfo&)>>& edgeWeightFuncs) const
 {
-    return vertexMap.size();
+    return freezeWith(
+        edgeWeightFuncs.size(),
+        [&](const DigraphEdge<EdgeInfo>& edge, std::vector<std::vector<double>>& weightColumns)
+        {
+            for (std::size_t c = 0; c < edgeWeightFuncs.size(); ++c)
+            {
+                weightColumns[c].push_back(edgeWeightFuncs[c](edge.einfo));
+            }
+        });
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
-int Digraph<VertexInfo, EdgeInfo>::edgeCount() const noexcept
+template <typename... EdgeWeightFuncs>
+FrozenDigraph Digraph<VertexInfo, EdgeInfo>::freeze(EdgeWeightFuncs... edgeWeightFuncs) const
 {
-    int count = 0;
-    for (auto it = vertexMap.begin(); it!= vertexMap.end(); it++)
-    {
-        for (auto i = it->second.edges.begin(); i != it->second.edges.end(); i ++)
+    return freezeWith(
+        sizeof...(EdgeWeightFuncs),
+        [&](const DigraphEdge<EdgeInfo>& edge, std::vector<std::vector<double>>& weightColumns)
         {
-            count ++;
+            std::size_t c = 0;
+            (weightColumns[c++].push_back(edgeWeightFuncs(edge.einfo)), ...);
+        });
+}
 
-        }
-    }
-    return count;
 
+template <typename VertexInfo, typename EdgeInfo>
+unsigned long long Digraph<VertexInfo, EdgeInfo>::version() const noexcept
+{
+    return modifications;
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
-int Digraph<VertexInfo, EdgeInfo>::edgeCount(int vertex) const
+unsigned int Digraph<VertexInfo, EdgeInfo>::indexOf(int vertex) const
 {
-    if (vertexMap.find(vertex) == vertexMap.end())
+    auto found = vertexIndices.find(vertex);
+
+    if (found == vertexIndices.end())
     {
-        throw DigraphException{"Vertex doesn't exist"};
+        throw DigraphException{"Vertex does not exist."};
     }
 
-    return vertexMap.at(vertex).edges.size();
+    return found->second;
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
-bool Digraph<VertexInfo, EdgeInfo>::isStronglyConnected() const
+bool Digraph<VertexInfo, EdgeInfo>::reachesEveryVertex(bool reversed) const
 {
-    for (auto it = vertexMap.begin(); it!= vertexMap.end(); it++)
+    if (vertexList.empty())
     {
-        for (auto i = vertexMap.at(it->first).edges.begin(); i != vertexMap.at(it->first).edges.end(); i ++)
+        return true;
+    }
+
+    std::vector<bool> reached(vertexList.size(), false);
+    std::vector<unsigned int> pending{0};
+    unsigned int reachedCount = 1;
+
+    reached[0] = true;
+
+    auto reach =
+        [&](unsigned int w)
         {
-            if (vertexMap.find(it->first) == vertexMap.end())
+            if (!reached[w])
             {
-                return false;
+                reached[w] = true;
+                ++reachedCount;
+                pending.push_back(w);
+            }
+        };
+
+    while (!pending.empty())
+    {
+        unsigned int v = pending.back();
+        pending.pop_back();
+
+        if (reversed)
+        {
+            for (const DigraphEdge<EdgeInfo>* edge : vertexList[v].incomingEdges)
+            {
+                reach(vertexIndices.at(edge->fromVertex));
+            }
+        }
+        else
+        {
+            for (const DigraphEdge<EdgeInfo>& edge : vertexList[v].edges)
+            {
+                reach(vertexIndices.at(edge.toVertex));
             }
         }
     }
 
-    return true;
-
+    return reachedCount == vertexList.size();
 }
 
 
 template <typename VertexInfo, typename EdgeInfo>
-std::map<int, int> Digraph<VertexInfo, EdgeInfo>::findShortestPaths(
-    int startVertex,
-    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+void Digraph<VertexInfo, EdgeInfo>::relinkIncomingEdges()
 {
-    
-    std::map<int,int> pv;
-    std::vector<bool> kv(vertexMap.size(),false);
-    std::map<int, int> dv;
+    for (DigraphVertex<VertexInfo, EdgeInfo>& vertex : vertexList)
+    {
+        vertex.incomingEdges.clear();
+    }
 
-   for (auto& [i,s] : vertexMap)
-   {
-        if (i != startVertex)
-        {
-            dv[i] = std::numeric_limits<int>::max();
-        }
-        else
+    for (DigraphVertex<VertexInfo, EdgeInfo>& vertex : vertexList)
+    {
+        for (const DigraphEdge<EdgeInfo>& edge : vertex.edges)
         {
-            dv[i] = 0;
-            pv[i] = i;
+            vertexList[vertexIndices.at(edge.toVertex)].incomingEdges.push_back(&edge);
         }
     }
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void Digraph<VertexInfo, EdgeInfo>::unlinkIncomingEdge(const DigraphEdge<EdgeInfo>& edge)
+{
+    std::vector<const DigraphEdge<EdgeInfo>*>& incomingEdges =
+        vertexList[vertexIndices.at(edge.toVertex)].incomingEdges;
+
+    incomingEdges.erase(std::find(incomingEdges.begin(), incomingEdges.end(), &edge));
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename AppendWeights>
+FrozenDigraph Digraph<VertexInfo, EdgeInfo>::freezeWith(
+    std::size_t columnCount, AppendWeights appendWeights) const
+{
+    // The frozen graph's indices are the same as this one's.
+    std::size_t edgeTotal = edgeCount();
+    std::vector<unsigned int> offsets;
+    std::vector<unsigned int> targets;
+    std::vector<std::vector<double>> weightColumns(columnCount);
 
-    std::priority_queue<int> pq;
-    pq.push(startVertex);
+    offsets.reserve(vertexList.size() + 1);
+    targets.reserve(edgeTotal);
 
-    while (!(pq.empty()))
+    for (std::vector<double>& column : weightColumns)
     {
-        int vertexV = pq.top();
-        pq.pop();
+        column.reserve(edgeTotal);
+    }
 
-        bool check = kv[vertexV];
+    for (const DigraphVertex<VertexInfo, EdgeInfo>& vertex : vertexList)
+    {
+        offsets.push_back(targets.size());
 
-        if (check == false)
+        for (const DigraphEdge<EdgeInfo>& edge : vertex.edges)
         {
-            check = true;
-        
-            for (auto& [c,b] : vertexMap)
-            {
-                if (c == vertexV)
-                {
-                    for (auto it = vertexMap.begin(); it!= vertexMap.end(); it++)
-                    {
-                        for (auto a = vertexMap.at(it->first).edges.begin(); a != vertexMap.at(it->first).edges.end(); a ++)
-                        {
-                            if (a->fromVertex == vertexV)
-                            {
-                                if (dv[a->toVertex] > dv[vertexV] + edgeWeightFunc(a->einfo))
-                                {
-                                    dv[a->toVertex] = dv[vertexV] + edgeWeightFunc(a->einfo);
-                                    pv[a->toVertex] = vertexV;
-                                    pq.push(a->toVertex);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+            targets.push_back(vertexIndices.at(edge.toVertex));
+            appendWeights(edge, weightColumns);
         }
-    
     }
-    return pv;
+
+    offsets.push_back(targets.size());
+
+    return FrozenDigraph{
+        vertexNumbers, std::move(offsets), std::move(targets),
+        std::move(weightColumns), modifications};
 }
 
 
 
 #endif
-
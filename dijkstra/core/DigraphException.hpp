@@ -0,0 +1,30 @@
+// DigraphException.hpp
+//
+// DigraphExceptions are thrown from some of the member functions in the
+// Digraph class template and in FrozenDigraph, so that exception is
+// declared here, so it will be available to any code that includes
+// either of their header files.
+
+#ifndef DIGRAPHEXCEPTION_HPP
+#define DIGRAPHEXCEPTION_HPP
+
+#include <stdexcept>
+#include <string>
+
+
+
+class DigraphException : public std::runtime_error
+{
+public:
+    DigraphException(const std::string& reason);
+};
+
+
+inline DigraphException::DigraphException(const std::string& reason)
+    : std::runtime_error{reason}
+{
+}
+
+
+
+#endif
@@ -0,0 +1,543 @@
+// FrozenDigraph.hpp
+//
+// A FrozenDigraph is an immutable snapshot of the structure of a Digraph,
+// laid out for searching rather than for changing, in what's called
+// compressed sparse row (CSR) form:
+//
+// * The vertices are numbered densely, from 0 to V - 1, in the same order
+//   as in the Digraph; these are called their "indices" below.
+// * The edges are stored in one array of targets (by index), grouped by
+//   the vertex they leave, so that the edges leaving the vertex with
+//   index v are the ones from offsets[v] up to offsets[v + 1].
+// * Rather than the edges' EdgeInfo objects, it stores one or more
+//   "weight columns", each an array holding one weight per edge, in the
+//   same order as the targets.  Typically, each column holds the weights
+//   by which some kind of trip is measured, such as distance or time.
+//
+// Searching a FrozenDigraph touches only a handful of flat arrays, where
+// searching a Digraph chases the nodes of trees and linked lists.
+//
+// A FrozenDigraph is built by Digraph::freeze(), and it doesn't change
+// when the Digraph does; it records the Digraph's version at that time,
+// so that a caller can tell when it needs to be built again.
+
+#ifndef FROZENDIGRAPH_HPP
+#define FROZENDIGRAPH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "DigraphException.hpp"
+#include "ShortestPath.hpp"
+
+
+
+class FrozenDigraph
+{
+public:
+    // Builds a FrozenDigraph from its arrays, as described above.  The
+    // vertex numbers must be distinct, there must be one more
+    // offset than there are vertices, and every weight column must have
+    // as many weights as there are targets.
+    FrozenDigraph(
+        std::vector<int> vertexNumbers, std::vector<unsigned int> offsets,
+        std::vector<unsigned int> targets, std::vector<std::vector<double>> weightColumns,
+        unsigned long long sourceVersion = 0);
+
+
+    // vertexCount() returns the number of vertices.
+    unsigned int vertexCount() const noexcept;
+
+
+    // edgeCount() returns the number of edges.
+    unsigned int edgeCount() const noexcept;
+
+
+    // columnCount() returns the number of weight columns.
+    unsigned int columnCount() const noexcept;
+
+
+    // sourceVersion() returns the version of the Digraph that this is a
+    // snapshot of, at the time it was taken.
+    unsigned long long sourceVersion() const noexcept;
+
+
+    // vertexNumber() returns the vertex number of the vertex with the
+    // given index.
+    int vertexNumber(unsigned int index) const noexcept;
+
+
+    // indexOf() returns the index of the vertex with the given vertex
+    // number.  If there is no such vertex, a DigraphException is thrown
+    // instead.
+    unsigned int indexOf(int vertexNumber) const;
+
+
+    // contains() returns true if there is a vertex with the given vertex
+    // number, false otherwise.
+    bool contains(int vertexNumber) const noexcept;
+
+
+    // firstEdge() and lastEdge() return the range of positions of the
+    // edges leaving the vertex with the given index.
+    unsigned int firstEdge(unsigned int index) const noexcept;
+    unsigned int lastEdge(unsigned int index) const noexcept;
+
+
+    // target() returns the index of the vertex that the edge at the given
+    // position points to.
+    unsigned int target(unsigned int edge) const noexcept;
+
+
+    // weight() returns the weight, in the given column, of the edge at
+    // the given position.
+    double weight(unsigned int column, unsigned int edge) const noexcept;
+
+
+    // weights() returns the whole of the given weight column.
+    const std::vector<double>& weights(unsigned int column) const noexcept;
+
+
+    // shortestPaths() uses Dijkstra's Shortest Path Algorithm to find the
+    // shortest paths from the vertex with the given index to every other
+    // vertex, using the weights in the given column.  Afterward,
+    // distances[v] is the length of the shortest path to the vertex with
+    // index v (or infinity if there's no path), and predecessors[v] is the
+    // index of the vertex before it on that path (or v itself, if v is the
+    // start or isn't reachable).  Both vectors are resized as needed.
+    void shortestPaths(
+        unsigned int startIndex, unsigned int column,
+        std::vector<double>& distances, std::vector<unsigned int>& predecessors) const;
+
+
+    // findShortestPaths() is like Digraph::findShortestPaths(): it returns
+    // a std::map in which each key is a vertex number and the value is
+    // the vertex number of its predecessor on the shortest path from the
+    // given start vertex, or a copy of the key if there's no predecessor.
+    std::map<int, int> findShortestPaths(int startVertex, unsigned int column = 0) const;
+
+
+    // findShortestPath() finds the shortest path from the given start
+    // vertex to the given end vertex, using the weights in the given
+    // column.  The search stops as soon as the end vertex's distance is
+    // known, so it settles only the vertices closer to the start than
+    // the end vertex is.  A DigraphException is thrown if either vertex
+    // does not exist.
+    ShortestPath findShortestPath(int startVertex, int endVertex, unsigned int column = 0) const;
+
+
+    // findShortestPathsTo() finds the shortest paths from the given start
+    // vertex to each of the given end vertices, in the same order, with
+    // one search that stops as soon as every end vertex's distance is
+    // known.  A DigraphException is thrown if any of the vertices does
+    // not exist.
+    std::vector<ShortestPath> findShortestPathsTo(
+        int startVertex, const std::vector<int>& endVertices, unsigned int column = 0) const;
+
+
+    // tracePath() builds the ShortestPath from the vertex with index
+    // startIndex to the one with index endIndex out of the predecessors
+    // left by a search from startIndex, such as shortestPaths(), using
+    // the weights in the given column.  The end vertex must have been
+    // reached, unless it's the start vertex.
+    ShortestPath tracePath(
+        unsigned int startIndex, unsigned int endIndex, unsigned int column,
+        const std::vector<unsigned int>& predecessors) const;
+
+
+    // reversed() returns a FrozenDigraph with the same vertices, in the
+    // same order, and every edge turned around, so that searching it from
+    // a vertex finds the shortest paths *to* that vertex in this one.
+    FrozenDigraph reversed() const;
+
+
+private:
+    std::vector<int> vertexNumbers;
+    std::unordered_map<int, unsigned int> vertexIndices;
+    std::vector<unsigned int> offsets;
+    std::vector<unsigned int> targets;
+    std::vector<std::vector<double>> weightColumns;
+    unsigned long long version;
+
+    // search() is the body of shortestPaths(), except that it stops once
+    // every vertex whose index is in endIndices is known; if there are
+    // none, it searches the whole graph.
+    void search(
+        unsigned int startIndex, const std::vector<unsigned int>& endIndices, unsigned int column,
+        std::vector<double>& distances, std::vector<unsigned int>& predecessors) const;
+};
+
+
+
+inline FrozenDigraph::FrozenDigraph(
+    std::vector<int> vertexNumbers, std::vector<unsigned int> offsets,
+    std::vector<unsigned int> targets, std::vector<std::vector<double>> weightColumns,
+    unsigned long long sourceVersion)
+    : vertexNumbers{std::move(vertexNumbers)}, offsets{std::move(offsets)},
+      targets{std::move(targets)}, weightColumns{std::move(weightColumns)},
+      version{sourceVersion}
+{
+    if (this->offsets.size() != this->vertexNumbers.size() + 1
+        || this->offsets.back() != this->targets.size())
+    {
+        throw DigraphException{"Inconsistent frozen digraph offsets"};
+    }
+
+    for (const std::vector<double>& column : this->weightColumns)
+    {
+        if (column.size() != this->targets.size())
+        {
+            throw DigraphException{"Inconsistent frozen digraph weights"};
+        }
+    }
+
+    vertexIndices.reserve(this->vertexNumbers.size());
+
+    for (unsigned int v = 0; v < this->vertexNumbers.size(); ++v)
+    {
+        if (!vertexIndices.emplace(this->vertexNumbers[v], v).second)
+        {
+            throw DigraphException{"Duplicate frozen digraph vertex number"};
+        }
+    }
+}
+
+
+inline unsigned int FrozenDigraph::vertexCount() const noexcept
+{
+    return vertexNumbers.size();
+}
+
+
+inline unsigned int FrozenDigraph::edgeCount() const noexcept
+{
+    return targets.size();
+}
+
+
+inline unsigned int FrozenDigraph::columnCount() const noexcept
+{
+    return weightColumns.size();
+}
+
+
+inline unsigned long long FrozenDigraph::sourceVersion() const noexcept
+{
+    return version;
+}
+
+
+inline int FrozenDigraph::vertexNumber(unsigned int index) const noexcept
+{
+    return vertexNumbers[index];
+}
+
+
+inline unsigned int FrozenDigraph::indexOf(int vertexNumber) const
+{
+    auto found = vertexIndices.find(vertexNumber);
+
+    if (found == vertexIndices.end())
+    {
+        throw DigraphException{"Vertex does not exist."};
+    }
+
+    return found->second;
+}
+
+
+inline bool FrozenDigraph::contains(int vertexNumber) const noexcept
+{
+    return vertexIndices.count(vertexNumber) != 0;
+}
+
+
+inline unsigned int FrozenDigraph::firstEdge(unsigned int index) const noexcept
+{
+    return offsets[index];
+}
+
+
+inline unsigned int FrozenDigraph::lastEdge(unsigned int index) const noexcept
+{
+    return offsets[index + 1];
+}
+
+
+inline unsigned int FrozenDigraph::target(unsigned int edge) const noexcept
+{
+    return targets[edge];
+}
+
+
+inline double FrozenDigraph::weight(unsigned int column, unsigned int edge) const noexcept
+{
+    return weightColumns[column][edge];
+}
+
+
+inline const std::vector<double>& FrozenDigraph::weights(unsigned int column) const noexcept
+{
+    return weightColumns[column];
+}
+
+
+inline void FrozenDigraph::shortestPaths(
+    unsigned int startIndex, unsigned int column,
+    std::vector<double>& distances, std::vector<unsigned int>& predecessors) const
+{
+    search(startIndex, {}, column, distances, predecessors);
+}
+
+
+inline void FrozenDigraph::search(
+    unsigned int startIndex, const std::vector<unsigned int>& endIndices, unsigned int column,
+    std::vector<double>& distances, std::vector<unsigned int>& predecessors) const
+{
+    const std::vector<double>& weight = weightColumns.at(column);
+
+    distances.assign(vertexNumbers.size(), std::numeric_limits<double>::infinity());
+    predecessors.resize(vertexNumbers.size());
+
+    for (unsigned int v = 0; v < predecessors.size(); ++v)
+    {
+        predecessors[v] = v;
+    }
+
+    std::vector<bool> known(vertexNumbers.size(), false);
+
+    // The end vertices are marked, so that the search can tell when it
+    // has reached them all; an end vertex listed more than once is only
+    // counted once.
+    std::vector<bool> isEnd;
+    std::size_t endsLeft = 0;
+
+    if (!endIndices.empty())
+    {
+        isEnd.assign(vertexNumbers.size(), false);
+
+        for (unsigned int endIndex : endIndices)
+        {
+            endsLeft += !isEnd[endIndex];
+            isEnd[endIndex] = true;
+        }
+    }
+
+    // The priority queue is ordered by distance, smallest first.  Rather
+    // than finding and updating a vertex's entry when a shorter path to
+    // it is found, another entry is pushed, and whichever entries come out
+    // after the vertex is already known are skipped.
+    using Entry = std::pair<double, unsigned int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+
+    distances[startIndex] = 0.0;
+    pq.emplace(0.0, startIndex);
+
+    while (!pq.empty())
+    {
+        auto [distance, v] = pq.top();
+        pq.pop();
+
+        if (known[v])
+        {
+            continue;
+        }
+
+        known[v] = true;
+
+        if (!isEnd.empty() && isEnd[v] && --endsLeft == 0)
+        {
+            return;
+        }
+
+        for (unsigned int e = offsets[v]; e < offsets[v + 1]; ++e)
+        {
+            unsigned int w = targets[e];
+            double throughV = distance + weight[e];
+
+            if (!known[w] && throughV < distances[w])
+            {
+                distances[w] = throughV;
+                predecessors[w] = v;
+                pq.emplace(throughV, w);
+            }
+        }
+    }
+}
+
+
+inline std::map<int, int> FrozenDigraph::findShortestPaths(int startVertex, unsigned int column) const
+{
+    std::vector<double> distances;
+    std::vector<unsigned int> predecessors(vertexNumbers.size());
+
+    if (contains(startVertex))
+    {
+        shortestPaths(indexOf(startVertex), column, distances, predecessors);
+    }
+    else
+    {
+        for (unsigned int v = 0; v < predecessors.size(); ++v)
+        {
+            predecessors[v] = v;
+        }
+    }
+
+    std::map<int, int> paths;
+
+    for (unsigned int v = 0; v < predecessors.size(); ++v)
+    {
+        paths.emplace(vertexNumbers[v], vertexNumbers[predecessors[v]]);
+    }
+
+    return paths;
+}
+
+
+inline ShortestPath FrozenDigraph::findShortestPath(int startVertex, int endVertex, unsigned int column) const
+{
+    unsigned int startIndex = indexOf(startVertex);
+    unsigned int endIndex = indexOf(endVertex);
+
+    std::vector<double> distances;
+    std::vector<unsigned int> predecessors;
+    search(startIndex, {endIndex}, column, distances, predecessors);
+
+    if (distances[endIndex] == std::numeric_limits<double>::infinity())
+    {
+        return ShortestPath{{}, {}, distances[endIndex]};
+    }
+
+    return tracePath(startIndex, endIndex, column, predecessors);
+}
+
+
+inline std::vector<ShortestPath> FrozenDigraph::findShortestPathsTo(
+    int startVertex, const std::vector<int>& endVertices, unsigned int column) const
+{
+    unsigned int startIndex = indexOf(startVertex);
+    std::vector<unsigned int> endIndices;
+    endIndices.reserve(endVertices.size());
+
+    for (int endVertex : endVertices)
+    {
+        endIndices.push_back(indexOf(endVertex));
+    }
+
+    std::vector<double> distances;
+    std::vector<unsigned int> predecessors;
+    std::vector<ShortestPath> paths;
+    paths.reserve(endIndices.size());
+
+    // With no end vertices, search() would search the whole graph, which
+    // isn't needed to find no paths.
+    if (!endIndices.empty())
+    {
+        search(startIndex, endIndices, column, distances, predecessors);
+    }
+
+    for (unsigned int endIndex : endIndices)
+    {
+        if (distances[endIndex] == std::numeric_limits<double>::infinity())
+        {
+            paths.push_back(ShortestPath{{}, {}, distances[endIndex]});
+        }
+        else
+        {
+            paths.push_back(tracePath(startIndex, endIndex, column, predecessors));
+        }
+    }
+
+    return paths;
+}
+
+
+inline ShortestPath FrozenDigraph::tracePath(
+    unsigned int startIndex, unsigned int endIndex, unsigned int column,
+    const std::vector<unsigned int>& predecessors) const
+{
+    const std::vector<double>& weight = weightColumns.at(column);
+    ShortestPath path{{}, {}, 0.0};
+
+    // The path is gathered backward from its end, then reversed.  Each
+    // segment's weight is the weight of the edge between its vertices;
+    // there's only one, since a Digraph has at most one edge from any
+    // vertex to any other.
+    for (unsigned int w = endIndex; w != startIndex; w = predecessors[w])
+    {
+        unsigned int v = predecessors[w];
+        unsigned int e = offsets[v];
+
+        while (targets[e] != w)
+        {
+            ++e;
+        }
+
+        path.vertices.push_back(vertexNumbers[w]);
+        path.segmentWeights.push_back(weight[e]);
+    }
+
+    path.vertices.push_back(vertexNumbers[startIndex]);
+
+    std::reverse(path.vertices.begin(), path.vertices.end());
+    std::reverse(path.segmentWeights.begin(), path.segmentWeights.end());
+
+    // Adding the weights up in path order repeats the search's own
+    // arithmetic, so the total is exactly the distance it found.
+    for (double segmentWeight : path.segmentWeights)
+    {
+        path.totalWeight += segmentWeight;
+    }
+
+    return path;
+}
+
+
+inline FrozenDigraph FrozenDigraph::reversed() const
+{
+    // This is a counting sort of the edges by target: count each vertex's
+    // incoming edges, turn the counts into offsets, then place each edge.
+    std::vector<unsigned int> reverseOffsets(vertexNumbers.size() + 1, 0);
+
+    for (unsigned int target : targets)
+    {
+        ++reverseOffsets[target + 1];
+    }
+
+    for (unsigned int v = 0; v < vertexNumbers.size(); ++v)
+    {
+        reverseOffsets[v + 1] += reverseOffsets[v];
+    }
+
+    std::vector<unsigned int> reverseTargets(targets.size());
+    std::vector<std::vector<double>> reverseColumns(
+        weightColumns.size(), std::vector<double>(targets.size()));
+    std::vector<unsigned int> next(reverseOffsets.begin(), reverseOffsets.end() - 1);
+
+    for (unsigned int v = 0; v < vertexNumbers.size(); ++v)
+    {
+        for (unsigned int e = offsets[v]; e < offsets[v + 1]; ++e)
+        {
+            unsigned int position = next[targets[e]]++;
+            reverseTargets[position] = v;
+
+            for (std::size_t c = 0; c < weightColumns.size(); ++c)
+            {
+                reverseColumns[c][position] = weightColumns[c][e];
+            }
+        }
+    }
+
+    return FrozenDigraph{
+        vertexNumbers, std::move(reverseOffsets), std::move(reverseTargets),
+        std::move(reverseColumns), version};
+}
+
+
+
+#endif
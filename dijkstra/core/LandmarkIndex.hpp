@@ -0,0 +1,310 @@
+// LandmarkIndex.hpp
+//
+// A LandmarkIndex speeds up point-to-point searches on a FrozenDigraph
+// using what's called ALT (A*, landmarks, and the triangle inequality).
+// A handful of vertices are chosen as "landmarks", and the distances from
+// each landmark to every vertex, and from every vertex to each landmark,
+// are found ahead of time.  For any landmark L, the triangle inequality
+// says that
+//
+//     d(v, t) >= d(L, t) - d(L, v)    and    d(v, t) >= d(v, L) - d(t, L)
+//
+// so the largest of these over all landmarks is a lower bound on the
+// distance from v to the end vertex t, without knowing anything about
+// where the vertices are.  An A* search guided by that bound settles the
+// vertices that lie roughly toward t, rather than every vertex closer to
+// the start than t is, as Dijkstra's algorithm does.
+//
+// Landmarks are chosen separately for each of the FrozenDigraph's weight
+// columns, since a vertex that's far away in distance needn't be far away
+// in time.  They're chosen by the "farthest" heuristic: each one is the
+// vertex farthest from the landmarks chosen before it, which tends to
+// spread them around the edges of the graph, where they give the best
+// bounds.
+//
+// A LandmarkIndex refers to the FrozenDigraph it was built from, which
+// must outlive it.
+
+#ifndef LANDMARKINDEX_HPP
+#define LANDMARKINDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "DigraphException.hpp"
+#include "FrozenDigraph.hpp"
+#include "ShortestPath.hpp"
+
+
+
+// A LandmarkSearchStats describes the work done by one search, so that it
+// can be compared with the work Dijkstra's algorithm would have done.
+
+struct LandmarkSearchStats
+{
+    unsigned int settledVertices;
+    unsigned int relaxedEdges;
+};
+
+
+
+class LandmarkIndex
+{
+public:
+    // Builds a LandmarkIndex for the given FrozenDigraph, with (at most)
+    // the given number of landmarks for each of its weight columns.  This
+    // takes two full searches per landmark per column.
+    LandmarkIndex(const FrozenDigraph& graph, unsigned int landmarkCount);
+
+
+    // landmarkCount() returns the number of landmarks for each column.
+    unsigned int landmarkCount() const noexcept;
+
+
+    // landmarks() returns the indices of the landmarks chosen for the
+    // given column, in the order they were chosen.
+    const std::vector<unsigned int>& landmarks(unsigned int column) const;
+
+
+    // memoryUsage() returns the number of bytes taken by the landmark
+    // distances, across every column.
+    std::size_t memoryUsage() const noexcept;
+
+
+    // lowerBound() returns a lower bound on the distance from the vertex
+    // with index fromIndex to the one with index toIndex, using the given
+    // column's weights.  It's infinity if the landmarks show that there's
+    // no path at all.
+    double lowerBound(unsigned int column, unsigned int fromIndex, unsigned int toIndex) const noexcept;
+
+
+    // findShortestPath() is like FrozenDigraph::findShortestPath(), but
+    // runs an A* search guided by lowerBound().  If stats is not null,
+    // the work done is stored there.  A DigraphException is thrown if
+    // either vertex does not exist.
+    ShortestPath findShortestPath(
+        int startVertex, int endVertex, unsigned int column = 0,
+        LandmarkSearchStats* stats = nullptr) const;
+
+
+private:
+    const FrozenDigraph& graph;
+    unsigned int count;
+    std::vector<std::vector<unsigned int>> landmarkIndices;
+
+    // For each column, fromLandmarks[column][v * count + l] is the
+    // distance from landmark l to the vertex with index v, and
+    // toLandmarks[column][v * count + l] the distance back, so that all
+    // of one vertex's distances sit together.
+    std::vector<std::vector<double>> fromLandmarks;
+    std::vector<std::vector<double>> toLandmarks;
+};
+
+
+
+inline LandmarkIndex::LandmarkIndex(const FrozenDigraph& graph, unsigned int landmarkCount)
+    : graph{graph}, count{std::min(landmarkCount, graph.vertexCount())},
+      landmarkIndices(graph.columnCount()),
+      fromLandmarks(graph.columnCount()), toLandmarks(graph.columnCount())
+{
+    FrozenDigraph reversedGraph = graph.reversed();
+    unsigned int vertexCount = graph.vertexCount();
+
+    std::vector<double> distances;
+    std::vector<unsigned int> predecessors;
+
+    for (unsigned int column = 0; column < graph.columnCount(); ++column)
+    {
+        fromLandmarks[column].resize(static_cast<std::size_t>(vertexCount) * count);
+        toLandmarks[column].resize(static_cast<std::size_t>(vertexCount) * count);
+
+        // nearest[v] is the distance from v to the nearest landmark chosen
+        // so far.  The first landmark is the vertex farthest from vertex
+        // 0, which is found the same way, as though vertex 0 were a
+        // landmark already.  Vertices that no landmark reaches count as
+        // farthest of all, since no landmark gives them a bound.
+        std::vector<double> nearest(vertexCount, std::numeric_limits<double>::infinity());
+        unsigned int next = 0;
+
+        if (vertexCount > 0)
+        {
+            graph.shortestPaths(0, column, distances, predecessors);
+            nearest = distances;
+            nearest[0] = 0.0;
+        }
+
+        for (unsigned int l = 0; l < count; ++l)
+        {
+            for (unsigned int v = 0; v < vertexCount; ++v)
+            {
+                if (nearest[v] > nearest[next])
+                {
+                    next = v;
+                }
+            }
+
+            landmarkIndices[column].push_back(next);
+
+            graph.shortestPaths(next, column, distances, predecessors);
+
+            for (unsigned int v = 0; v < vertexCount; ++v)
+            {
+                fromLandmarks[column][static_cast<std::size_t>(v) * count + l] = distances[v];
+                nearest[v] = std::min(nearest[v], distances[v]);
+            }
+
+            reversedGraph.shortestPaths(next, column, distances, predecessors);
+
+            for (unsigned int v = 0; v < vertexCount; ++v)
+            {
+                toLandmarks[column][static_cast<std::size_t>(v) * count + l] = distances[v];
+            }
+        }
+    }
+}
+
+
+inline unsigned int LandmarkIndex::landmarkCount() const noexcept
+{
+    return count;
+}
+
+
+inline const std::vector<unsigned int>& LandmarkIndex::landmarks(unsigned int column) const
+{
+    return landmarkIndices.at(column);
+}
+
+
+inline std::size_t LandmarkIndex::memoryUsage() const noexcept
+{
+    std::size_t bytes = 0;
+
+    for (std::size_t column = 0; column < fromLandmarks.size(); ++column)
+    {
+        bytes += (fromLandmarks[column].size() + toLandmarks[column].size()) * sizeof(double);
+    }
+
+    return bytes;
+}
+
+
+inline double LandmarkIndex::lowerBound(
+    unsigned int column, unsigned int fromIndex, unsigned int toIndex) const noexcept
+{
+    const double* fromV = fromLandmarks[column].data() + static_cast<std::size_t>(fromIndex) * count;
+    const double* fromT = fromLandmarks[column].data() + static_cast<std::size_t>(toIndex) * count;
+    const double* toV = toLandmarks[column].data() + static_cast<std::size_t>(fromIndex) * count;
+    const double* toT = toLandmarks[column].data() + static_cast<std::size_t>(toIndex) * count;
+
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    double bound = 0.0;
+
+    // A bound is only usable when the distance being subtracted is
+    // finite.  If the other one is infinite, so is the bound; that's
+    // right, because it means the landmark is reachable from (or can
+    // reach) one of the vertices, but not the other.
+    for (unsigned int l = 0; l < count; ++l)
+    {
+        if (fromV[l] != infinity)
+        {
+            bound = std::max(bound, fromT[l] - fromV[l]);
+        }
+
+        if (toT[l] != infinity)
+        {
+            bound = std::max(bound, toV[l] - toT[l]);
+        }
+    }
+
+    return bound;
+}
+
+
+inline ShortestPath LandmarkIndex::findShortestPath(
+    int startVertex, int endVertex, unsigned int column,
+    LandmarkSearchStats* stats) const
+{
+    unsigned int startIndex = graph.indexOf(startVertex);
+    unsigned int endIndex = graph.indexOf(endVertex);
+    const std::vector<double>& weight = graph.weights(column);
+
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    unsigned int vertexCount = graph.vertexCount();
+
+    std::vector<double> distances(vertexCount, infinity);
+    std::vector<unsigned int> predecessors(vertexCount);
+    std::vector<bool> known(vertexCount, false);
+    LandmarkSearchStats work{0, 0};
+
+    // The priority queue is ordered by distance plus lower bound.  The
+    // landmark bounds are consistent (an edge's weight is never less than
+    // the amount by which it lowers the bound), so, as in Dijkstra's
+    // algorithm, a vertex's distance is final once it comes out.
+    using Entry = std::pair<double, unsigned int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+
+    distances[startIndex] = 0.0;
+    predecessors[startIndex] = startIndex;
+    pq.emplace(lowerBound(column, startIndex, endIndex), startIndex);
+
+    while (!pq.empty())
+    {
+        unsigned int v = pq.top().second;
+        pq.pop();
+
+        if (known[v])
+        {
+            continue;
+        }
+
+        known[v] = true;
+        ++work.settledVertices;
+
+        if (v == endIndex)
+        {
+            break;
+        }
+
+        for (unsigned int e = graph.firstEdge(v); e < graph.lastEdge(v); ++e)
+        {
+            unsigned int w = graph.target(e);
+            double throughV = distances[v] + weight[e];
+            ++work.relaxedEdges;
+
+            if (!known[w] && throughV < distances[w])
+            {
+                double bound = lowerBound(column, w, endIndex);
+
+                // A vertex from which the end can't be reached is never
+                // worth visiting.
+                if (bound != infinity)
+                {
+                    distances[w] = throughV;
+                    predecessors[w] = v;
+                    pq.emplace(throughV + bound, w);
+                }
+            }
+        }
+    }
+
+    if (stats != nullptr)
+    {
+        *stats = work;
+    }
+
+    if (!known[endIndex])
+    {
+        return ShortestPath{{}, {}, infinity};
+    }
+
+    return graph.tracePath(startIndex, endIndex, column, predecessors);
+}
+
+
+
+#endif
@@ -0,0 +1,33 @@
+// ShortestPath.hpp
+//
+// A ShortestPath describes the shortest path found from one vertex to
+// another, as returned by Digraph::findShortestPath() and
+// FrozenDigraph::findShortestPath(), so that the path can be followed
+// without walking a map of predecessors backward from its end.
+
+#ifndef SHORTESTPATH_HPP
+#define SHORTESTPATH_HPP
+
+#include <vector>
+
+
+
+// vertices lists the vertex numbers along the path, from the start vertex
+// to the end vertex.  segmentWeights lists the weight of each edge taken,
+// so there is one fewer of them than there are vertices, and totalWeight
+// is their sum.
+//
+// When there is no path, vertices and segmentWeights are empty and
+// totalWeight is infinity.  When the start and end vertices are the same,
+// vertices holds just that one vertex and totalWeight is 0.
+
+struct ShortestPath
+{
+    std::vector<int> vertices;
+    std::vector<double> segmentWeights;
+    double totalWeight;
+};
+
+
+
+#endif
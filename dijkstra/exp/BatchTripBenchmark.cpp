@@ -0,0 +1,140 @@
+// BatchTripBenchmark.cpp
+//
+// Compares finding a batch of trips one at a time, with one search per
+// trip, with finding them through a BatchTripPlanner, which shares one
+// search among the trips with the same start and metric and spreads the
+// searches across threads.  The trips come from a limited number of start
+// locations, as they would from a handful of depots or households.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <vector>
+#include "BatchTripPlanner.hpp"
+#include "BenchmarkRoadMaps.hpp"
+#include "Benchmarks.hpp"
+#include "TripMetricWeights.hpp"
+
+
+namespace
+{
+    constexpr unsigned int MAP_SIZE = 200;
+    constexpr unsigned int START_COUNT = 64;
+    constexpr unsigned int TRIP_COUNT = 4096;
+
+
+    template <typename Function>
+    double timeMilliseconds(Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count();
+    }
+
+
+    // makeSharedStartTrips() returns trips whose start locations are drawn
+    // from a small set, each trip with a random end location and metric.
+    std::vector<Trip> makeSharedStartTrips(const RoadMap& roadMap, unsigned int seed)
+    {
+        std::default_random_engine engine{seed};
+        std::vector<Trip> startTrips = makeTrips(roadMap, START_COUNT, seed);
+        std::vector<Trip> endTrips = makeTrips(roadMap, TRIP_COUNT, seed + 1);
+
+        std::vector<Trip> trips;
+
+        for (const Trip& endTrip : endTrips)
+        {
+            trips.push_back(Trip{
+                startTrips[engine() % START_COUNT].startVertex, endTrip.endVertex,
+                engine() % 2 == 0 ? TripMetric::Distance : TripMetric::Time});
+        }
+
+        return trips;
+    }
+
+
+    double totalWeight(const std::vector<ShortestPath>& paths)
+    {
+        double total = 0.0;
+
+        for (const ShortestPath& path : paths)
+        {
+            total += path.totalWeight;
+        }
+
+        return total;
+    }
+}
+
+
+void runBatchTripBenchmark(std::ostream& out)
+{
+    RoadMap roadMap = makeRoadMap(MAP_SIZE, MAP_SIZE, 48);
+    std::vector<Trip> trips = makeSharedStartTrips(roadMap, 48);
+    FrozenDigraph frozenMap = freezeRoadMap(roadMap);
+
+    std::vector<ShortestPath> expected;
+
+    double oneAtATime = timeMilliseconds(
+        [&]
+        {
+            for (const Trip& trip : trips)
+            {
+                expected.push_back(frozenMap.findShortestPath(
+                    trip.startVertex, trip.endVertex, tripMetricColumn(trip.metric)));
+            }
+        });
+
+    double expectedTotal = totalWeight(expected);
+
+    out << frozenMap.vertexCount() << " locations, " << TRIP_COUNT << " trips from "
+        << START_COUNT << " starts" << std::endl;
+
+    out << std::setw(14) << "planner"
+        << std::setw(10) << "threads"
+        << std::setw(10) << "groups"
+        << std::setw(12) << "time (ms)"
+        << std::setw(14) << "trips/sec"
+        << std::setw(11) << "speedup"
+        << std::setw(6) << "same" << std::endl;
+
+    out << std::setw(14) << "one-at-a-time" << std::fixed << std::setprecision(1)
+        << std::setw(10) << 1
+        << std::setw(10) << TRIP_COUNT
+        << std::setw(12) << oneAtATime
+        << std::setw(14) << TRIP_COUNT / (oneAtATime / 1000.0)
+        << std::setw(10) << 1.0 << "x"
+        << std::setw(6) << "-" << std::endl;
+
+    // At least four threads are always tried, so that the results are
+    // checked for a multithreaded batch even on a machine with fewer cores.
+    unsigned int cores = std::max(4u, std::thread::hardware_concurrency());
+
+    for (unsigned int threadCount = 1; threadCount <= cores; threadCount *= 2)
+    {
+        std::vector<ShortestPath> paths;
+        BatchTripReport report = BatchTripPlanner{frozenMap, threadCount}.findTrips(trips, paths);
+
+        // The paths must come back in the trips' order, so they're compared
+        // one by one, not just in total.
+        bool same = std::abs(totalWeight(paths) - expectedTotal) < 1e-6 * expectedTotal;
+
+        for (std::size_t i = 0; i < paths.size() && same; ++i)
+        {
+            same = paths[i].vertices == expected[i].vertices;
+        }
+
+        out << std::setw(14) << "batch"
+            << std::setw(10) << threadCount
+            << std::setw(10) << report.groups
+            << std::setw(12) << report.seconds * 1000.0
+            << std::setw(14) << report.tripsPerSecond()
+            << std::setw(10) << oneAtATime / (report.seconds * 1000.0) << "x"
+            << std::setw(6) << (same ? "yes" : "no") << std::endl;
+    }
+}
@@ -0,0 +1,86 @@
+// BenchmarkRoadMaps.cpp
+
+#include <random>
+#include <string>
+#include "BenchmarkRoadMaps.hpp"
+
+
+namespace
+{
+    constexpr unsigned int HIGHWAY_SPACING = 10;
+    constexpr unsigned int ONE_WAY_PERCENT = 10;
+
+
+    void addRoad(
+        RoadMap& roadMap, std::default_random_engine& engine,
+        int from, int to, bool highway)
+    {
+        std::uniform_real_distribution<double> miles{0.2, 2.0};
+        std::uniform_int_distribution<int> streetSpeed{5, 9};
+
+        double length = miles(engine);
+        double speed = highway ? 65.0 : streetSpeed(engine) * 5.0;
+        bool oneWay = !highway && engine() % 100 < ONE_WAY_PERCENT;
+
+        roadMap.addEdge(from, to, RoadSegment{length, speed});
+
+        if (!oneWay)
+        {
+            roadMap.addEdge(to, from, RoadSegment{length, speed});
+        }
+    }
+}
+
+
+RoadMap makeRoadMap(unsigned int width, unsigned int height, unsigned int seed)
+{
+    std::default_random_engine engine{seed};
+    RoadMap roadMap;
+
+    for (unsigned int row = 0; row < height; ++row)
+    {
+        for (unsigned int column = 0; column < width; ++column)
+        {
+            roadMap.addVertex(row * width + column, std::to_string(row) + "," + std::to_string(column));
+        }
+    }
+
+    for (unsigned int row = 0; row < height; ++row)
+    {
+        for (unsigned int column = 0; column < width; ++column)
+        {
+            int vertex = row * width + column;
+
+            if (column + 1 < width)
+            {
+                addRoad(roadMap, engine, vertex, vertex + 1, row % HIGHWAY_SPACING == 0);
+            }
+
+            if (row + 1 < height)
+            {
+                addRoad(roadMap, engine, vertex, vertex + width, column % HIGHWAY_SPACING == 0);
+            }
+        }
+    }
+
+    return roadMap;
+}
+
+
+std::vector<Trip> makeTrips(const RoadMap& roadMap, unsigned int count, unsigned int seed)
+{
+    std::default_random_engine engine{seed};
+    std::vector<int> vertices = roadMap.vertices();
+    std::uniform_int_distribution<std::size_t> pick{0, vertices.size() - 1};
+
+    std::vector<Trip> trips;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        trips.push_back(Trip{
+            vertices[pick(engine)], vertices[pick(engine)],
+            i % 2 == 0 ? TripMetric::Distance : TripMetric::Time});
+    }
+
+    return trips;
+}
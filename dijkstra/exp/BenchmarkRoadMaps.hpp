@@ -0,0 +1,28 @@
+// BenchmarkRoadMaps.hpp
+//
+// Synthetic road maps and trips for the benchmarks.  A road map is a grid
+// of city streets, most of them two-way, with a faster highway along
+// every tenth row and column, so that (as on a real map) the shortest
+// trip by distance and the shortest trip by time often differ.
+
+#ifndef BENCHMARKROADMAPS_HPP
+#define BENCHMARKROADMAPS_HPP
+
+#include <vector>
+#include "RoadMap.hpp"
+#include "Trip.hpp"
+
+
+
+// makeRoadMap() returns a road map whose locations form a grid of the
+// given width and height, numbered by row from 0.
+RoadMap makeRoadMap(unsigned int width, unsigned int height, unsigned int seed);
+
+
+// makeTrips() returns the given number of trips between randomly-chosen
+// locations on the given road map, alternating between the two metrics.
+std::vector<Trip> makeTrips(const RoadMap& roadMap, unsigned int count, unsigned int seed);
+
+
+
+#endif
@@ -0,0 +1,42 @@
+// Benchmarks.hpp
+//
+// Declares the benchmarks that expmain() can run.  Each one writes its
+// results, as a small table, to the given output stream.
+
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+#include <ostream>
+
+
+
+// Compares finding a batch of trips one at a time with finding them
+// through a BatchTripPlanner, with increasing numbers of threads.
+void runBatchTripBenchmark(std::ostream& out);
+
+
+// Compares point-to-point trips found by Dijkstra's algorithm with those
+// found through a RoadMapHierarchies, including the time and memory it
+// takes to build the hierarchies, on road maps of several sizes.
+void runContractionHierarchyBenchmark(std::ostream& out);
+
+
+// Compares Dijkstra's algorithm with parallel delta-stepping, for several
+// bucket widths and numbers of threads, in searches of a whole road map.
+void runDeltaSteppingBenchmark(std::ostream& out);
+
+
+// Compares point-to-point trips found by Dijkstra's algorithm with those
+// found by A* searches guided by a LandmarkIndex, for several numbers of
+// landmarks, including the time and memory it takes to build the index.
+void runLandmarkBenchmark(std::ostream& out);
+
+
+// Compares weighing edges through a std::function, through an inlinable
+// function object, and by loading materialized weights, in searches of a
+// road map by driving time.
+void runWeightFunctorBenchmark(std::ostream& out);
+
+
+
+#endif
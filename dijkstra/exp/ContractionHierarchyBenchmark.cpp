@@ -0,0 +1,110 @@
+// ContractionHierarchyBenchmark.cpp
+//
+// Compares finding trips with Dijkstra's algorithm (stopping once the end
+// of each trip is reached) with finding them through a RoadMapHierarchies.
+// For each metric, it reports the time taken to build its hierarchy, the
+// number of shortcuts and memory it takes, and the average number of
+// vertices settled and time taken per trip, for road maps of a few sizes.
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <optional>
+#include <vector>
+#include "BenchmarkRoadMaps.hpp"
+#include "Benchmarks.hpp"
+#include "RoadMapHierarchies.hpp"
+#include "TripMetricWeights.hpp"
+
+
+namespace
+{
+    constexpr unsigned int TRIP_COUNT = 1000;
+
+
+    template <typename Function>
+    double timeMilliseconds(Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count();
+    }
+}
+
+
+void runContractionHierarchyBenchmark(std::ostream& out)
+{
+    out << std::setw(10) << "locations"
+        << std::setw(8) << "metric"
+        << std::setw(12) << "build (ms)"
+        << std::setw(11) << "shortcuts"
+        << std::setw(10) << "MB"
+        << std::setw(10) << "settled"
+        << std::setw(14) << "dijkstra us"
+        << std::setw(10) << "CH us"
+        << std::setw(11) << "speedup"
+        << std::setw(6) << "same" << std::endl;
+
+    for (unsigned int size : {100u, 200u, 400u})
+    {
+        RoadMap roadMap = makeRoadMap(size, size, 47);
+        std::vector<Trip> trips = makeTrips(roadMap, TRIP_COUNT, 47);
+
+        std::optional<RoadMapHierarchies> built;
+        double build = timeMilliseconds([&] { built.emplace(roadMap); });
+        const RoadMapHierarchies& hierarchies = *built;
+
+        for (TripMetric metric : {TripMetric::Distance, TripMetric::Time})
+        {
+            const ContractionHierarchy& hierarchy = hierarchies.hierarchy(metric);
+            unsigned int column = tripMetricColumn(metric);
+
+            // The total length of the trips is kept so that the searches
+            // can't be optimized away, and to check that both find the
+            // same trips.
+            double dijkstraTotal = 0.0;
+            double hierarchyTotal = 0.0;
+            unsigned long long settled = 0;
+
+            double dijkstra = timeMilliseconds(
+                [&]
+                {
+                    for (const Trip& trip : trips)
+                    {
+                        dijkstraTotal += hierarchies.frozenMap().findShortestPath(
+                            trip.startVertex, trip.endVertex, column).totalWeight;
+                    }
+                });
+
+            double query = timeMilliseconds(
+                [&]
+                {
+                    for (const Trip& trip : trips)
+                    {
+                        ContractionSearchStats stats;
+                        hierarchyTotal += hierarchy.findShortestPath(
+                            trip.startVertex, trip.endVertex, &stats).totalWeight;
+                        settled += stats.settledVertices;
+                    }
+                });
+
+            // Both hierarchies are built together, so the build time is
+            // split evenly between them.
+            out << std::setw(10) << size * size
+                << std::setw(8) << (metric == TripMetric::Distance ? "D" : "T")
+                << std::fixed << std::setprecision(1)
+                << std::setw(12) << build / 2.0
+                << std::setw(11) << hierarchy.shortcutCount()
+                << std::setw(10) << hierarchy.memoryUsage() / 1048576.0
+                << std::setw(10) << static_cast<double>(settled) / TRIP_COUNT
+                << std::setw(14) << dijkstra * 1000.0 / TRIP_COUNT
+                << std::setw(10) << query * 1000.0 / TRIP_COUNT
+                << std::setw(10) << dijkstra / query << "x"
+                << std::setw(6)
+                << (std::abs(dijkstraTotal - hierarchyTotal) < 1e-6 * dijkstraTotal ? "yes" : "no")
+                << std::endl;
+        }
+    }
+}
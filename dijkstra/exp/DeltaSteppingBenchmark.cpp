@@ -0,0 +1,114 @@
+// DeltaSteppingBenchmark.cpp
+//
+// Compares finding the shortest paths from one location of a large road
+// map to every other by Dijkstra's algorithm with finding them by
+// delta-stepping, for several bucket widths and numbers of threads.  The
+// bucket widths are given as multiples of the average road segment's
+// driving time.
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include "BenchmarkRoadMaps.hpp"
+#include "Benchmarks.hpp"
+#include "DeltaStepping.hpp"
+#include "TripMetricWeights.hpp"
+
+
+namespace
+{
+    constexpr unsigned int MAP_SIZE = 400;
+    constexpr unsigned int SEARCH_COUNT = 5;
+
+
+    template <typename Function>
+    double timeMilliseconds(Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count();
+    }
+}
+
+
+void runDeltaSteppingBenchmark(std::ostream& out)
+{
+    RoadMap roadMap = makeRoadMap(MAP_SIZE, MAP_SIZE, 50);
+    std::vector<Trip> trips = makeTrips(roadMap, SEARCH_COUNT, 50);
+    FrozenDigraph frozenMap = freezeRoadMap(roadMap);
+    unsigned int column = tripMetricColumn(TripMetric::Time);
+
+    double averageWeight = 0.0;
+
+    for (double weight : frozenMap.weights(column))
+    {
+        averageWeight += weight;
+    }
+
+    averageWeight /= frozenMap.edgeCount();
+
+    std::vector<std::vector<unsigned int>> expected(SEARCH_COUNT);
+    std::vector<double> distances;
+
+    double dijkstra = timeMilliseconds(
+        [&]
+        {
+            for (unsigned int i = 0; i < SEARCH_COUNT; ++i)
+            {
+                frozenMap.shortestPaths(
+                    frozenMap.indexOf(trips[i].startVertex), column, distances, expected[i]);
+            }
+        });
+
+    out << frozenMap.vertexCount() << " locations, " << frozenMap.edgeCount()
+        << " road segments, by driving time" << std::endl;
+
+    out << std::setw(14) << "search"
+        << std::setw(8) << "delta"
+        << std::setw(10) << "threads"
+        << std::setw(14) << "ms/search"
+        << std::setw(11) << "speedup"
+        << std::setw(6) << "same" << std::endl;
+
+    out << std::setw(14) << "dijkstra" << std::fixed << std::setprecision(1)
+        << std::setw(8) << "-"
+        << std::setw(10) << 1
+        << std::setw(14) << dijkstra / SEARCH_COUNT
+        << std::setw(10) << 1.0 << "x"
+        << std::setw(6) << "-" << std::endl;
+
+    // At least four threads are always tried, so that the results are
+    // checked for a multithreaded search even on a machine with fewer
+    // cores.
+    unsigned int cores = std::max(4u, std::thread::hardware_concurrency());
+
+    for (double multiple : {0.5, 2.0, 8.0, 32.0})
+    {
+        for (unsigned int threadCount = 1; threadCount <= cores; threadCount *= 2)
+        {
+            DeltaStepping deltaStepping{frozenMap, column, multiple * averageWeight, threadCount};
+            std::vector<std::vector<unsigned int>> predecessors(SEARCH_COUNT);
+
+            double time = timeMilliseconds(
+                [&]
+                {
+                    for (unsigned int i = 0; i < SEARCH_COUNT; ++i)
+                    {
+                        deltaStepping.shortestPaths(
+                            frozenMap.indexOf(trips[i].startVertex), distances, predecessors[i]);
+                    }
+                });
+
+            out << std::setw(14) << "delta-stepping"
+                << std::setw(7) << multiple << "x"
+                << std::setw(10) << threadCount
+                << std::setw(14) << time / SEARCH_COUNT
+                << std::setw(10) << dijkstra / time << "x"
+                << std::setw(6) << (predecessors == expected ? "yes" : "no") << std::endl;
+        }
+    }
+}
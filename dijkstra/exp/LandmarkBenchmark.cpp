@@ -0,0 +1,113 @@
+// LandmarkBenchmark.cpp
+//
+// Compares finding trips with Dijkstra's algorithm (stopping once the end
+// of each trip is reached) with finding them by A* searches guided by a
+// LandmarkIndex.  For each number of landmarks, it reports the time taken
+// to build the index, the memory taken by each landmark's distances (in
+// both directions, for both metrics), and the average number of vertices
+// settled and time taken per trip.
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <optional>
+#include <vector>
+#include "BenchmarkRoadMaps.hpp"
+#include "Benchmarks.hpp"
+#include "LandmarkIndex.hpp"
+#include "TripMetricWeights.hpp"
+
+
+namespace
+{
+    constexpr unsigned int MAP_SIZE = 300;
+    constexpr unsigned int TRIP_COUNT = 200;
+
+
+    template <typename Function>
+    double timeMilliseconds(Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count();
+    }
+}
+
+
+void runLandmarkBenchmark(std::ostream& out)
+{
+    RoadMap roadMap = makeRoadMap(MAP_SIZE, MAP_SIZE, 46);
+    std::vector<Trip> trips = makeTrips(roadMap, TRIP_COUNT, 46);
+    FrozenDigraph frozenMap = freezeRoadMap(roadMap);
+
+    // The total length of the trips is kept so that the searches can't be
+    // optimized away, and to check that every kind finds the same trips.
+    double dijkstraTotal = 0.0;
+
+    double dijkstra = timeMilliseconds(
+        [&]
+        {
+            for (const Trip& trip : trips)
+            {
+                dijkstraTotal += frozenMap.findShortestPath(
+                    trip.startVertex, trip.endVertex, tripMetricColumn(trip.metric)).totalWeight;
+            }
+        });
+
+    out << frozenMap.vertexCount() << " locations, "
+        << frozenMap.edgeCount() << " road segments, "
+        << TRIP_COUNT << " trips" << std::endl;
+
+    out << std::setw(10) << "landmarks"
+        << std::setw(12) << "build (ms)"
+        << std::setw(14) << "KB/landmark"
+        << std::setw(12) << "settled"
+        << std::setw(14) << "us/trip"
+        << std::setw(11) << "speedup"
+        << std::setw(8) << "same" << std::endl;
+
+    out << std::setw(10) << "dijkstra" << std::fixed << std::setprecision(1)
+        << std::setw(12) << "-"
+        << std::setw(14) << "-"
+        << std::setw(12) << "-"
+        << std::setw(14) << dijkstra * 1000.0 / TRIP_COUNT
+        << std::setw(11) << "-"
+        << std::setw(8) << "-" << std::endl;
+
+    // With no landmarks, the A* search settles exactly the vertices that
+    // Dijkstra's algorithm does, which gives the baseline count.
+    for (unsigned int landmarkCount : {0u, 4u, 8u, 16u})
+    {
+        std::optional<LandmarkIndex> index;
+        double build = timeMilliseconds([&] { index.emplace(frozenMap, landmarkCount); });
+
+        double total = 0.0;
+        unsigned long long settled = 0;
+
+        double search = timeMilliseconds(
+            [&]
+            {
+                for (const Trip& trip : trips)
+                {
+                    LandmarkSearchStats stats;
+                    total += index->findShortestPath(
+                        trip.startVertex, trip.endVertex, tripMetricColumn(trip.metric), &stats).totalWeight;
+                    settled += stats.settledVertices;
+                }
+            });
+
+        double perLandmark =
+            landmarkCount == 0 ? 0.0 : index->memoryUsage() / 1024.0 / landmarkCount;
+
+        out << std::setw(10) << landmarkCount
+            << std::setw(12) << build
+            << std::setw(14) << perLandmark
+            << std::setw(12) << static_cast<double>(settled) / TRIP_COUNT
+            << std::setw(14) << search * 1000.0 / TRIP_COUNT
+            << std::setw(10) << dijkstra / search << "x"
+            << std::setw(8) << (std::abs(total - dijkstraTotal) < 1e-6 * dijkstraTotal ? "yes" : "no")
+            << std::endl;
+    }
+}
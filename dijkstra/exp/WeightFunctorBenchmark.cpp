@@ -0,0 +1,157 @@
+// WeightFunctorBenchmark.cpp
+//
+// Compares the ways of weighing a RoadMap's edges by driving time in a
+// search: through a std::function, through the TimeWeight function object
+// (which the compiler can inline), and by loading weights materialized
+// ahead of time in a FrozenDigraph's weight column.  Both whole searches
+// (findShortestPaths()) and point-to-point searches (findShortestPath())
+// are timed.
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <optional>
+#include <vector>
+#include "BenchmarkRoadMaps.hpp"
+#include "Benchmarks.hpp"
+#include "TripMetricWeights.hpp"
+
+
+namespace
+{
+    constexpr unsigned int MAP_SIZE = 300;
+    constexpr unsigned int WHOLE_SEARCHES = 10;
+    constexpr unsigned int TRIP_COUNT = 200;
+
+
+    template <typename Function>
+    double timeMilliseconds(Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        return elapsed.count();
+    }
+
+
+    // reachedCount() returns the number of vertices with a predecessor
+    // other than themselves in the given result of findShortestPaths().
+    unsigned long reachedCount(const std::map<int, int>& predecessors)
+    {
+        unsigned long reached = 0;
+
+        for (const auto& [vertex, predecessor] : predecessors)
+        {
+            if (vertex != predecessor)
+            {
+                ++reached;
+            }
+        }
+
+        return reached;
+    }
+
+
+    void writeRow(
+        std::ostream& out, const char* name, double wholeMs, unsigned long reached, double tripMs, double total)
+    {
+        out << std::setw(18) << name << std::fixed << std::setprecision(2)
+            << std::setw(16) << wholeMs / WHOLE_SEARCHES
+            << std::setw(10) << reached
+            << std::setw(14) << tripMs * 1000.0 / TRIP_COUNT
+            << std::setw(14) << total << std::endl;
+    }
+}
+
+
+void runWeightFunctorBenchmark(std::ostream& out)
+{
+    RoadMap roadMap = makeRoadMap(MAP_SIZE, MAP_SIZE, 49);
+    std::vector<Trip> trips = makeTrips(roadMap, TRIP_COUNT, 49);
+    std::function<double(const RoadSegment&)> timeFunction = tripMetricWeight(TripMetric::Time);
+
+    out << roadMap.vertexCount() << " locations, " << roadMap.edgeCount() << " road segments" << std::endl;
+    out << std::setw(18) << "weights"
+        << std::setw(16) << "all paths (ms)"
+        << std::setw(10) << "reached"
+        << std::setw(14) << "us/trip"
+        << std::setw(14) << "total hours" << std::endl;
+
+    // The whole searches are compared by the number of vertices with a
+    // predecessor ("reached"), the trips by their total length, so that
+    // neither can be optimized away.
+    unsigned long reached = 0;
+    double total = 0.0;
+
+    double whole = timeMilliseconds(
+        [&]
+        {
+            for (unsigned int i = 0; i < WHOLE_SEARCHES; ++i)
+            {
+                reached += reachedCount(roadMap.findShortestPaths(trips[i].startVertex, timeFunction));
+            }
+        });
+
+    double trip = timeMilliseconds(
+        [&]
+        {
+            for (const Trip& t : trips)
+            {
+                total += roadMap.findShortestPath(t.startVertex, t.endVertex, timeFunction).totalWeight;
+            }
+        });
+
+    writeRow(out, "std::function", whole, reached, trip, total);
+    reached = 0;
+    total = 0.0;
+
+    whole = timeMilliseconds(
+        [&]
+        {
+            for (unsigned int i = 0; i < WHOLE_SEARCHES; ++i)
+            {
+                reached += reachedCount(roadMap.findShortestPaths(trips[i].startVertex, TimeWeight{}));
+            }
+        });
+
+    trip = timeMilliseconds(
+        [&]
+        {
+            for (const Trip& t : trips)
+            {
+                total += roadMap.findShortestPath(t.startVertex, t.endVertex, TimeWeight{}).totalWeight;
+            }
+        });
+
+    writeRow(out, "TimeWeight", whole, reached, trip, total);
+    reached = 0;
+    total = 0.0;
+
+    // The materialized weights are frozen once, as a program finding many
+    // trips would do, and the time to freeze is reported separately.
+    std::optional<FrozenDigraph> frozenMap;
+    double freezing = timeMilliseconds([&] { frozenMap.emplace(roadMap.freeze(TimeWeight{})); });
+
+    whole = timeMilliseconds(
+        [&]
+        {
+            for (unsigned int i = 0; i < WHOLE_SEARCHES; ++i)
+            {
+                reached += reachedCount(frozenMap->findShortestPaths(trips[i].startVertex));
+            }
+        });
+
+    trip = timeMilliseconds(
+        [&]
+        {
+            for (const Trip& t : trips)
+            {
+                total += frozenMap->findShortestPath(t.startVertex, t.endVertex).totalWeight;
+            }
+        });
+
+    writeRow(out, "materialized", whole, reached, trip, total);
+    out << "(freezing took " << freezing << " ms)" << std::endl;
+}
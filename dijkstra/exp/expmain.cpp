@@ -3,15 +3,52 @@
 // ICS 46 Winter 2022
 // Project #5: Rock and Roll Stops the Traffic
 //
-// Do whatever you'd like here.  This is intended to allow you to experiment
-// with your code, outside of the context of the broader program or Google
-// Test.
+// This is intended to allow you to experiment with your code, outside of
+// the context of the broader program or Google Test.  Each benchmark is
+// run by naming it on the command line; with no arguments, all of them
+// are run.
 
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include "Benchmarks.hpp"
 
-int main()
+
+int main(int argc, char** argv)
 {
+    const std::map<std::string, std::function<void(std::ostream&)>> benchmarks{
+        {"batch-trips", runBatchTripBenchmark},
+        {"contraction-hierarchies", runContractionHierarchyBenchmark},
+        {"delta-stepping", runDeltaSteppingBenchmark},
+        {"landmarks", runLandmarkBenchmark},
+        {"weight-functors", runWeightFunctorBenchmark}
+    };
+
+    if (argc < 2)
+    {
+        for (const auto& [name, benchmark] : benchmarks)
+        {
+            std::cout << "== " << name << " ==" << std::endl;
+            benchmark(std::cout);
+            std::cout << std::endl;
+        }
+
+        return 0;
+    }
 
+    for (int i = 1; i < argc; ++i)
+    {
+        auto benchmark = benchmarks.find(argv[i]);
+
+        if (benchmark == benchmarks.end())
+        {
+            std::cout << "Unknown benchmark: " << argv[i] << std::endl;
+            return 1;
+        }
+
+        benchmark->second(std::cout);
+    }
 
     return 0;
 }
-
@@ -0,0 +1,99 @@
+// BatchTripPlanner_SanityCheckTests.cpp
+
+
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BatchTripPlanner.hpp"
+#include "DigraphException.hpp"
+#include "RoadMap.hpp"
+#include "TripMetricWeights.hpp"
+
+
+TEST(BatchTripPlanner_SanityCheckTests, findsTheSamePathsAsOneTripAtATime)
+{
+    std::mt19937 random{48};
+    RoadMap roadMap;
+    int locationCount = 60;
+
+    for (int v = 0; v < locationCount; ++v)
+    {
+        roadMap.addVertex(v * 2, "Location" + std::to_string(v));
+    }
+
+    // Location 118 (the last one) has no roads, so trips to it have no
+    // path.
+    for (int e = 0; e < locationCount * 3; ++e)
+    {
+        int from = random() % (locationCount - 1) * 2;
+        int to = random() % (locationCount - 1) * 2;
+
+        try
+        {
+            roadMap.addEdge(from, to, RoadSegment{random() % 20 + 1.0, random() % 4 * 15 + 25.0});
+        }
+        catch (DigraphException&)
+        {
+        }
+    }
+
+    FrozenDigraph frozenMap = freezeRoadMap(roadMap);
+
+    // A few starts are shared by many trips, with both metrics, so that
+    // trips are grouped; some trips are repeated, some start where they
+    // end, and some can't be made at all.
+    std::vector<Trip> trips;
+
+    for (int i = 0; i < 300; ++i)
+    {
+        trips.push_back(Trip{
+            static_cast<int>(random() % 5) * 2,
+            static_cast<int>(random() % locationCount) * 2,
+            random() % 2 == 0 ? TripMetric::Distance : TripMetric::Time});
+    }
+
+    trips.push_back(trips.front());
+    trips.push_back(Trip{4, 4, TripMetric::Time});
+    trips.push_back(Trip{118, 0, TripMetric::Distance});
+
+    for (unsigned int threadCount : {1u, 4u})
+    {
+        std::vector<ShortestPath> paths;
+        BatchTripReport report = BatchTripPlanner{frozenMap, threadCount}.findTrips(trips, paths);
+
+        ASSERT_EQ(trips.size(), report.trips);
+        // Five starts with two metrics each, plus the trip from 118.
+        ASSERT_EQ(11, report.groups);
+        ASSERT_EQ(trips.size(), paths.size());
+
+        for (std::size_t i = 0; i < trips.size(); ++i)
+        {
+            ShortestPath expected = frozenMap.findShortestPath(
+                trips[i].startVertex, trips[i].endVertex, tripMetricColumn(trips[i].metric));
+
+            ASSERT_EQ(expected.vertices, paths[i].vertices);
+            ASSERT_EQ(expected.segmentWeights, paths[i].segmentWeights);
+            ASSERT_EQ(expected.totalWeight, paths[i].totalWeight);
+        }
+    }
+}
+
+
+TEST(BatchTripPlanner_SanityCheckTests, rejectsMissingVerticesAndWeightColumns)
+{
+    RoadMap roadMap;
+    roadMap.addVertex(1, "Location1");
+    roadMap.addVertex(2, "Location2");
+    roadMap.addEdge(1, 2, RoadSegment{3.0, 30.0});
+
+    FrozenDigraph frozenMap = freezeRoadMap(roadMap);
+    BatchTripPlanner planner{frozenMap, 2};
+    std::vector<Trip> trips{Trip{1, 2, TripMetric::Time}, Trip{1, 3, TripMetric::Time}};
+    std::vector<ShortestPath> paths;
+
+    ASSERT_THROW({ planner.findTrips(trips, paths); }, DigraphException);
+
+    FrozenDigraph distancesOnly = roadMap.freeze(DistanceWeight{});
+    ASSERT_THROW({ BatchTripPlanner(distancesOnly, 2); }, DigraphException);
+}
@@ -2,11 +2,17 @@
 
 
 #include <algorithm>
+#include <limits>
+#include <random>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <gtest/gtest.h>
+#include "ContractionHierarchy.hpp"
+#include "DeltaStepping.hpp"
 #include "Digraph.hpp"
+#include "LandmarkIndex.hpp"
 
 
 TEST(Digraph_SanityCheckTests, canConstructAndDestroy)
@@ -195,6 +201,88 @@ TEST(Digraph_SanityCheckTests, cannotGetVertexInfoAfterRemovingVertex)
 }
 
 
+TEST(Digraph_SanityCheckTests, removingVertexKeepsOtherVerticesAndRemovesItsIncomingEdges)
+{
+    Digraph<std::string, std::string> d1;
+    d1.addVertex(100, "Example1");
+    d1.addVertex(-7, "Example2");
+    d1.addVertex(5000, "Example3");
+
+    d1.addEdge(100, -7, "Edge1");
+    d1.addEdge(5000, -7, "Edge2");
+    d1.addEdge(-7, 5000, "Edge3");
+    d1.addEdge(5000, 100, "Edge4");
+
+    d1.removeVertex(-7);
+
+    ASSERT_EQ(2, d1.vertexCount());
+    ASSERT_EQ(1, d1.edgeCount());
+    ASSERT_EQ("Example1", d1.vertexInfo(100));
+    ASSERT_EQ("Example3", d1.vertexInfo(5000));
+    ASSERT_EQ("Edge4", d1.edgeInfo(5000, 100));
+    ASSERT_THROW({ d1.edgeInfo(100, -7); }, DigraphException);
+}
+
+
+namespace
+{
+    // A CopyOnlyInfo can be copied but has no move constructor, so a
+    // std::vector of vertices holding one copies them when it grows.
+    struct CopyOnlyInfo
+    {
+        std::string name;
+
+        CopyOnlyInfo(const std::string& name)
+            : name{name}
+        {
+        }
+
+        CopyOnlyInfo(const CopyOnlyInfo& info)
+            : name{info.name}
+        {
+        }
+
+        CopyOnlyInfo& operator=(const CopyOnlyInfo& info)
+        {
+            name = info.name;
+            return *this;
+        }
+    };
+}
+
+
+TEST(Digraph_SanityCheckTests, edgesSurviveAddingManyVerticesWithCopyOnlyInfo)
+{
+    Digraph<CopyOnlyInfo, double> d1;
+    d1.addVertex(1, CopyOnlyInfo{"Example1"});
+    d1.addVertex(2, CopyOnlyInfo{"Example2"});
+    d1.addEdge(1, 2, 1.5);
+    d1.addEdge(2, 1, 2.5);
+
+    for (int i = 3; i <= 200; ++i)
+    {
+        d1.addVertex(i, CopyOnlyInfo{"Example" + std::to_string(i)});
+        d1.addEdge(i, 1, i);
+    }
+
+    d1.removeVertex(1);
+
+    ASSERT_EQ(199, d1.vertexCount());
+    ASSERT_EQ(0, d1.edgeCount());
+    ASSERT_EQ("Example200", d1.vertexInfo(200).name);
+
+    d1.addVertex(1, CopyOnlyInfo{"Example1"});
+    d1.addEdge(2, 1, 3.0);
+    d1.addEdge(1, 200, 4.0);
+
+    ShortestPath path = d1.findShortestPathBidirectional(
+        2, 200, [](double edgeInfo) { return edgeInfo; });
+
+    ASSERT_EQ((std::vector<int>{2, 1, 200}), path.vertices);
+    ASSERT_DOUBLE_EQ(7.0, path.totalWeight);
+}
+
+
 TEST(Digraph_SanityCheckTests, cannotGetEdgeInfoAfterRemovingEdge)
 {
     Digraph<std::string, std::string> d1;
@@ -292,6 +380,21 @@ TEST(Digraph_SanityCheckTests, isStronglyConnectedWhenAllPossibleEdgesArePresent
 }
 
 
+TEST(Digraph_SanityCheckTests, isNotStronglyConnectedWhenAVertexCannotBeLeft)
+{
+    Digraph<int, int> d1;
+    d1.addVertex(1, 10);
+    d1.addVertex(2, 20);
+    d1.addVertex(3, 30);
+
+    d1.addEdge(1, 2, 50);
+    d1.addEdge(2, 1, 50);
+    d1.addEdge(2, 3, 50);
+
+    ASSERT_FALSE(d1.isStronglyConnected());
+}
+
+
 
 
 TEST(Digraph_SanityCheckTests, canFindShortestPathWhenNoChoicesAreToBeMade)
@@ -311,18 +414,454 @@ TEST(Digraph_SanityCheckTests, canFindShortestPathWhenNoChoicesAreToBeMade)
             return edgeInfo;
         });
 
-    /*
     ASSERT_EQ(3, paths.size());
 
     ASSERT_TRUE(paths.find(1) != paths.end());
     ASSERT_TRUE(paths.find(2) != paths.end());
     ASSERT_TRUE(paths.find(3) != paths.end());
 
-    
     ASSERT_EQ(1, paths[1]);
     ASSERT_EQ(1, paths[2]);
     ASSERT_EQ(2, paths[3]);
-    */
-    
 }
 
+
+TEST(Digraph_SanityCheckTests, canFindShortestPathWhenTheDirectEdgeIsLonger)
+{
+    Digraph<int, double> d1;
+    d1.addVertex(1, 10);
+    d1.addVertex(2, 20);
+    d1.addVertex(3, 30);
+    d1.addVertex(4, 40);
+
+    d1.addEdge(1, 4, 10.0);
+    d1.addEdge(1, 2, 1.5);
+    d1.addEdge(2, 3, 2.5);
+    d1.addEdge(3, 4, 3.5);
+    d1.addEdge(4, 1, 1.0);
+
+    std::map<int, int> paths = d1.findShortestPaths(
+        1,
+        [](double edgeInfo)
+        {
+            return edgeInfo;
+        });
+
+    ASSERT_EQ(4, paths.size());
+    ASSERT_EQ(1, paths[1]);
+    ASSERT_EQ(1, paths[2]);
+    ASSERT_EQ(2, paths[3]);
+    ASSERT_EQ(3, paths[4]);
+}
+
+
+TEST(Digraph_SanityCheckTests, unreachedVerticesAreTheirOwnPredecessors)
+{
+    Digraph<int, double> d1;
+    d1.addVertex(1, 10);
+    d1.addVertex(2, 20);
+    d1.addVertex(3, 30);
+
+    d1.addEdge(1, 2, 1.0);
+    d1.addEdge(3, 1, 1.0);
+
+    std::map<int, int> paths = d1.findShortestPaths(
+        1,
+        [](double edgeInfo)
+        {
+            return edgeInfo;
+        });
+
+    ASSERT_EQ(3, paths.size());
+    ASSERT_EQ(1, paths[1]);
+    ASSERT_EQ(1, paths[2]);
+    ASSERT_EQ(3, paths[3]);
+}
+
+
+
+TEST(Digraph_SanityCheckTests, canFindShortestPathsOnFrozenDigraphByColumn)
+{
+    Digraph<int, std::pair<double, double>> d1;
+    d1.addVertex(5, 10);
+    d1.addVertex(7, 20);
+    d1.addVertex(9, 30);
+
+    d1.addEdge(5, 9, {1.0, 10.0});
+    d1.addEdge(5, 7, {2.0, 2.0});
+    d1.addEdge(7, 9, {2.0, 2.0});
+
+    FrozenDigraph frozen = d1.freeze({
+        [](const std::pair<double, double>& e) { return e.first; },
+        [](const std::pair<double, double>& e) { return e.second; }});
+
+    ASSERT_EQ(3, frozen.vertexCount());
+    ASSERT_EQ(3, frozen.edgeCount());
+    ASSERT_EQ(2, frozen.columnCount());
+    ASSERT_EQ(d1.version(), frozen.sourceVersion());
+
+    std::map<int, int> byFirst = frozen.findShortestPaths(5, 0);
+    std::map<int, int> bySecond = frozen.findShortestPaths(5, 1);
+
+    ASSERT_EQ(5, byFirst[9]);
+    ASSERT_EQ(7, bySecond[9]);
+
+    d1.removeEdge(5, 7);
+    ASSERT_NE(d1.version(), frozen.sourceVersion());
+    ASSERT_EQ(3, frozen.edgeCount());
+}
+
+
+TEST(Digraph_SanityCheckTests, canFindShortestPathBetweenTwoVertices)
+{
+    Digraph<int, double> d1;
+    d1.addVertex(1, 10);
+    d1.addVertex(2, 20);
+    d1.addVertex(3, 30);
+    d1.addVertex(4, 40);
+    d1.addVertex(5, 50);
+
+    d1.addEdge(1, 4, 10.0);
+    d1.addEdge(1, 2, 1.5);
+    d1.addEdge(2, 3, 2.5);
+    d1.addEdge(3, 4, 3.5);
+    d1.addEdge(4, 1, 1.0);
+
+    auto weight = [](double edgeInfo) { return edgeInfo; };
+    FrozenDigraph frozen = d1.freeze({weight});
+
+    for (const ShortestPath& path : {d1.findShortestPath(1, 4, weight), frozen.findShortestPath(1, 4)})
+    {
+        ASSERT_EQ((std::vector<int>{1, 2, 3, 4}), path.vertices);
+        ASSERT_EQ((std::vector<double>{1.5, 2.5, 3.5}), path.segmentWeights);
+        ASSERT_DOUBLE_EQ(7.5, path.totalWeight);
+    }
+
+    for (const ShortestPath& path : {d1.findShortestPath(3, 3, weight), frozen.findShortestPath(3, 3)})
+    {
+        ASSERT_EQ((std::vector<int>{3}), path.vertices);
+        ASSERT_TRUE(path.segmentWeights.empty());
+        ASSERT_DOUBLE_EQ(0.0, path.totalWeight);
+    }
+
+    for (const ShortestPath& path : {d1.findShortestPath(1, 5, weight), frozen.findShortestPath(1, 5)})
+    {
+        ASSERT_TRUE(path.vertices.empty());
+        ASSERT_EQ(std::numeric_limits<double>::infinity(), path.totalWeight);
+    }
+
+    ASSERT_THROW({ d1.findShortestPath(1, 6, weight); }, DigraphException);
+    ASSERT_THROW({ frozen.findShortestPath(6, 1); }, DigraphException);
+}
+
+
+namespace
+{
+    // makeRandomDigraph() builds a Digraph of vertexCount vertices,
+    // numbered numberOf(0) through numberOf(vertexCount - 1), with
+    // vertexCount * 3 attempts at adding an edge between two of them
+    // chosen at random, whose info is makeEdgeInfo(random).  Edges that
+    // addEdge() rejects are skipped.
+    template <typename NumberOf, typename MakeEdgeInfo>
+    Digraph<int, std::invoke_result_t<MakeEdgeInfo&, std::mt19937&>> makeRandomDigraph(
+        unsigned int seed, int vertexCount, NumberOf numberOf, MakeEdgeInfo makeEdgeInfo)
+    {
+        std::mt19937 random{seed};
+        Digraph<int, std::invoke_result_t<MakeEdgeInfo&, std::mt19937&>> d;
+
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            d.addVertex(numberOf(v), v);
+        }
+
+        for (int e = 0; e < vertexCount * 3; ++e)
+        {
+            int from = numberOf(random() % vertexCount);
+            int to = numberOf(random() % vertexCount);
+
+            try
+            {
+                d.addEdge(from, to, makeEdgeInfo(random));
+            }
+            catch (DigraphException&)
+            {
+            }
+        }
+
+        return d;
+    }
+}
+
+
+TEST(Digraph_SanityCheckTests, bidirectionalSearchAgreesWithFindShortestPathsOnRandomGraphs)
+{
+    auto weight = [](double edgeInfo) { return edgeInfo; };
+
+    for (int trial = 0; trial < 40; ++trial)
+    {
+        Digraph<int, double> d1 = makeRandomDigraph(
+            4600 + trial, 2 + trial,
+            [](int v) { return v * 3 + 1; },
+            [](std::mt19937& random) { return static_cast<double>(random() % 20); });
+
+        // Removing a vertex has to take its incoming edges out of the
+        // backward search, too.
+        if (trial % 4 == 3)
+        {
+            d1.removeVertex(4);
+        }
+
+        Digraph<int, double> copy{d1};
+
+        for (int start : copy.vertices())
+        {
+            std::map<int, int> paths = copy.findShortestPaths(start, weight);
+
+            for (int end : copy.vertices())
+            {
+                ShortestPath path = copy.findShortestPathBidirectional(start, end, weight);
+
+                if (end != start && paths[end] == end)
+                {
+                    ASSERT_TRUE(path.vertices.empty());
+                    continue;
+                }
+
+                double expected = 0.0;
+
+                for (int v = end; v != start; v = paths[v])
+                {
+                    expected += copy.edgeInfo(paths[v], v);
+                }
+
+                ASSERT_EQ(expected, path.totalWeight);
+                ASSERT_EQ(start, path.vertices.front());
+                ASSERT_EQ(end, path.vertices.back());
+
+                double total = 0.0;
+
+                for (std::size_t i = 0; i < path.segmentWeights.size(); ++i)
+                {
+                    ASSERT_EQ(copy.edgeInfo(path.vertices[i], path.vertices[i + 1]), path.segmentWeights[i]);
+                    total += path.segmentWeights[i];
+                }
+
+                ASSERT_EQ(expected, total);
+            }
+        }
+    }
+}
+
+
+TEST(Digraph_SanityCheckTests, landmarkSearchFindsShortestPathsOnRandomGraphs)
+{
+    for (int trial = 0; trial < 20; ++trial)
+    {
+        Digraph<int, std::pair<double, double>> d1 = makeRandomDigraph(
+            4700 + trial, 5 + trial * 3,
+            [](int v) { return v * 2; },
+            [](std::mt19937& random) { return std::pair<double, double>{random() % 20 + 1.0, random() % 5 + 1.0}; });
+
+        FrozenDigraph frozen = d1.freeze({
+            [](const std::pair<double, double>& e) { return e.first; },
+            [](const std::pair<double, double>& e) { return e.second; }});
+
+        LandmarkIndex index{frozen, 4};
+
+        ASSERT_EQ(4, index.landmarkCount());
+        ASSERT_EQ(4, index.landmarks(1).size());
+
+        for (unsigned int column = 0; column < 2; ++column)
+        {
+            for (int start : d1.vertices())
+            {
+                for (int end : d1.vertices())
+                {
+                    ShortestPath expected = frozen.findShortestPath(start, end, column);
+                    LandmarkSearchStats stats;
+                    ShortestPath path = index.findShortestPath(start, end, column, &stats);
+
+                    ASSERT_EQ(expected.totalWeight, path.totalWeight);
+                    ASSERT_LE(index.lowerBound(column, frozen.indexOf(start), frozen.indexOf(end)), path.totalWeight);
+
+                    if (!path.vertices.empty())
+                    {
+                        ASSERT_EQ(start, path.vertices.front());
+                        ASSERT_EQ(end, path.vertices.back());
+                        ASSERT_EQ(path.vertices.size(), path.segmentWeights.size() + 1);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+TEST(Digraph_SanityCheckTests, contractionHierarchyFindsShortestPathsOnRandomGraphs)
+{
+    for (int trial = 0; trial < 20; ++trial)
+    {
+        Digraph<int, std::pair<double, double>> d1 = makeRandomDigraph(
+            4800 + trial, 5 + trial * 4,
+            [](int v) { return v * 5 - 20; },
+            [](std::mt19937& random) { return std::pair<double, double>{random() % 20 + 1.0, random() % 3 + 1.0}; });
+
+        FrozenDigraph frozen = d1.freeze({
+            [](const std::pair<double, double>& e) { return e.first; },
+            [](const std::pair<double, double>& e) { return e.second; }});
+
+        for (unsigned int column = 0; column < 2; ++column)
+        {
+            ContractionHierarchy hierarchy{frozen, column};
+
+            for (int start : d1.vertices())
+            {
+                for (int end : d1.vertices())
+                {
+                    ShortestPath expected = frozen.findShortestPath(start, end, column);
+                    ShortestPath path = hierarchy.findShortestPath(start, end);
+
+                    ASSERT_EQ(expected.totalWeight, path.totalWeight);
+
+                    if (path.vertices.empty())
+                    {
+                        continue;
+                    }
+
+                    ASSERT_EQ(start, path.vertices.front());
+                    ASSERT_EQ(end, path.vertices.back());
+                    ASSERT_EQ(path.vertices.size(), path.segmentWeights.size() + 1);
+
+                    for (std::size_t i = 0; i < path.segmentWeights.size(); ++i)
+                    {
+                        std::pair<double, double> edge = d1.edgeInfo(path.vertices[i], path.vertices[i + 1]);
+                        ASSERT_EQ(column == 0 ? edge.first : edge.second, path.segmentWeights[i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+TEST(Digraph_SanityCheckTests, canFindShortestPathsToSeveralVerticesInOneSearch)
+{
+    Digraph<int, double> d1;
+    d1.addVertex(1, 10);
+    d1.addVertex(2, 20);
+    d1.addVertex(3, 30);
+    d1.addVertex(4, 40);
+    d1.addVertex(5, 50);
+
+    d1.addEdge(1, 4, 10.0);
+    d1.addEdge(1, 2, 1.5);
+    d1.addEdge(2, 3, 2.5);
+    d1.addEdge(3, 4, 3.5);
+    d1.addEdge(4, 1, 1.0);
+
+    FrozenDigraph frozen = d1.freeze({[](double edgeInfo) { return edgeInfo; }});
+    std::vector<ShortestPath> paths = frozen.findShortestPathsTo(1, {4, 2, 5, 4, 1});
+
+    ASSERT_EQ(5, paths.size());
+    ASSERT_EQ((std::vector<int>{1, 2, 3, 4}), paths[0].vertices);
+    ASSERT_EQ((std::vector<int>{1, 2}), paths[1].vertices);
+    ASSERT_TRUE(paths[2].vertices.empty());
+    ASSERT_EQ(paths[0].vertices, paths[3].vertices);
+    ASSERT_EQ((std::vector<int>{1}), paths[4].vertices);
+    ASSERT_DOUBLE_EQ(7.5, paths[3].totalWeight);
+
+    ASSERT_THROW({ frozen.findShortestPathsTo(1, {2, 6}); }, DigraphException);
+}
+
+
+TEST(Digraph_SanityCheckTests, deltaSteppingFindsTheSamePredecessorsOnRandomGraphs)
+{
+    for (int trial = 0; trial < 20; ++trial)
+    {
+        Digraph<int, std::pair<double, double>> d1 = makeRandomDigraph(
+            5000 + trial, 5 + trial * 4,
+            [](int v) { return v * 3 + 1; },
+            [](std::mt19937& random) { return std::pair<double, double>{random() % 20 + 1.0, random() % 4 / 2.0}; });
+
+        // The second column has edges of weight 0, and many equal
+        // distances, so that ties have to be broken the same way.
+        FrozenDigraph frozen = d1.freeze({
+            [](const std::pair<double, double>& e) { return e.first; },
+            [](const std::pair<double, double>& e) { return e.second; }});
+
+        for (unsigned int column = 0; column < 2; ++column)
+        {
+            for (double delta : {0.5, 3.0, 25.0})
+            {
+                for (unsigned int threadCount : {1u, 3u})
+                {
+                    DeltaStepping deltaStepping{frozen, column, delta, threadCount};
+
+                    for (int start : d1.vertices())
+                    {
+                        ASSERT_EQ(frozen.findShortestPaths(start, column), deltaStepping.findShortestPaths(start));
+
+                        std::vector<double> expectedDistances, distances;
+                        std::vector<unsigned int> expectedPredecessors, predecessors;
+                        frozen.shortestPaths(frozen.indexOf(start), column, expectedDistances, expectedPredecessors);
+                        deltaStepping.shortestPaths(frozen.indexOf(start), distances, predecessors);
+
+                        ASSERT_EQ(expectedDistances, distances);
+                        ASSERT_EQ(expectedPredecessors, predecessors);
+                    }
+                }
+            }
+        }
+    }
+
+    Digraph<int, double> d2;
+    d2.addVertex(1, 10);
+
+    FrozenDigraph frozen = d2.freeze({[](double edgeInfo) { return edgeInfo; }});
+    ASSERT_THROW({ DeltaStepping(frozen, 0, 0.0); }, DigraphException);
+    ASSERT_THROW({ DeltaStepping(frozen, 1, 1.0); }, DigraphException);
+}
+
+
+TEST(Digraph_SanityCheckTests, deltaSteppingHandlesInfiniteWeightsAndFarBuckets)
+{
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    Digraph<int, double> d1;
+
+    for (int v = 1; v <= 6; ++v)
+    {
+        d1.addVertex(v, v);
+    }
+
+    d1.addEdge(1, 2, infinity);
+    d1.addEdge(1, 3, 1.0);
+    d1.addEdge(3, 4, 1e6);
+    d1.addEdge(4, 2, 0.5);
+    d1.addEdge(3, 5, 2.0);
+    d1.addEdge(5, 6, 1e300);
+    d1.addEdge(6, 1, 1.0);
+
+    FrozenDigraph frozen = d1.freeze({[](double edgeInfo) { return edgeInfo; }});
+
+    // With a tiny delta, the distances span more buckets than the window
+    // holds, and the last ones too many to number at all.
+    for (double delta : {1e-9, 0.75, 1e301})
+    {
+        for (unsigned int threadCount : {1u, 3u})
+        {
+            DeltaStepping deltaStepping{frozen, 0, delta, threadCount};
+
+            for (int start : d1.vertices())
+            {
+                std::vector<double> expectedDistances, distances;
+                std::vector<unsigned int> expectedPredecessors, predecessors;
+                frozen.shortestPaths(frozen.indexOf(start), 0, expectedDistances, expectedPredecessors);
+                deltaStepping.shortestPaths(frozen.indexOf(start), distances, predecessors);
+
+                ASSERT_EQ(expectedDistances, distances);
+                ASSERT_EQ(expectedPredecessors, predecessors);
+            }
+        }
+    }
+}